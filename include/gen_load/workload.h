@@ -0,0 +1,129 @@
+/*
+ * \brief  Calibrated periodic workload
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * A workload releases the jobs of one periodic task on absolute
+ * times and burns its wcet in a busy loop that is calibrated at
+ * startup. The response time of every job is measured with the
+ * cycle counter and submitted as CSV report "jobs". The task is
+ * configured via the config ROM, all times in us:
+ *
+ * <config period_us="100000" wcet_us="10000" deadline_us="100000"
+ *         jobs="100" jitter_us="0" offset_us="0" seed="1"
+ *         report_every="100"/>
+ *
+ * Without a Report service only a summary is logged at the end.
+ * jobs="0" runs forever. A job is released jitter_us at most after
+ * its nominal release. If a job is released while the previous one
+ * still runs, it starts late and its response time includes the
+ * delay.
+ */
+
+#ifndef _INCLUDE__GEN_LOAD__WORKLOAD_H_
+#define _INCLUDE__GEN_LOAD__WORKLOAD_H_
+
+#include <base/stdint.h>
+#include <report_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/xml_node.h>
+
+namespace Gen_load {
+
+	struct Task_params
+	{
+		unsigned long long period_us   = 1000000;
+		unsigned long long wcet_us     = 100000;
+		unsigned long long deadline_us = 0;    /* 0 for the period */
+		unsigned long long jitter_us   = 0;
+		unsigned long long offset_us   = 0;
+		unsigned long jobs             = 0;    /* 0 for infinitely many */
+		unsigned long report_every     = 100;  /* jobs per report */
+		unsigned seed                  = 1;
+
+		/**
+		 * Read the attributes of a config node, missing ones keep their value
+		 */
+		void read(Genode::Xml_node node);
+
+		unsigned long long deadline() const { return deadline_us ? deadline_us : period_us; }
+	};
+
+	struct Job_result
+	{
+		Genode::uint64_t release_us;  /* since the start of the workload */
+		Genode::uint64_t response_us; /* from the release to the end of the job */
+	};
+
+	/**
+	 * Busy loop that runs for a given time without a timer
+	 */
+	class Busy_loop
+	{
+		private:
+
+			unsigned long long _iterations_per_ms = 0;
+			unsigned long long _cycles_per_ms = 0;  /* of Trace::timestamp(), per ms to keep the fraction of a MHz */
+			volatile Genode::uint64_t _sink = 0;
+
+			void _spin(unsigned long long iterations);
+
+		public:
+
+			/**
+			 * Measure the speed of the loop and of the cycle counter
+			 *
+			 * \param window_ms  duration of a calibration run
+			 */
+			void calibrate(Timer::Connection &timer, unsigned long window_ms = 200);
+
+			void run_us(unsigned long long us) { _spin(us * _iterations_per_ms / 1000); }
+
+			/**
+			 * Time in us since an arbitrary start, from the cycle counter
+			 */
+			unsigned long long now_us() const;
+
+			unsigned long long iterations_per_ms() const { return _iterations_per_ms; }
+			unsigned long long cycles_per_ms() const { return _cycles_per_ms; }
+	};
+
+	class Workload
+	{
+		private:
+
+			Timer::Connection &_timer;
+			Busy_loop &_loop;
+			Task_params _params;
+
+			Job_result *_results;   /* ring of report_every results */
+			unsigned long _done = 0;
+			unsigned long _reported = 0;
+			unsigned long _misses = 0;
+			unsigned long long _max_response_us = 0;
+			unsigned long long _sum_response_us = 0;
+			unsigned _random;
+
+			Report::Connection *_report = nullptr; /* nullptr without a Report service */
+			char *_report_buf = nullptr;
+			Genode::size_t _report_size;
+
+			unsigned long long _jitter();
+			void _report_results();
+
+		public:
+
+			Workload(Timer::Connection &timer, Busy_loop &loop, Task_params const &params);
+			~Workload();
+
+			/**
+			 * Release all jobs, returns after the last one if jobs is finite
+			 */
+			void run();
+
+			unsigned long jobs() const { return _done; }
+			unsigned long misses() const { return _misses; }
+	};
+}
+
+#endif /* _INCLUDE__GEN_LOAD__WORKLOAD_H_ */
@@ -17,20 +17,40 @@ namespace Rq_task
 
 	enum class Task_strategy { priority, deadline };
 
-	struct Rq_task
+	/*
+	 * Element of the run queues shared with the kernel, see
+	 * Sched_controller::Rq_buffer. The kernel reads the tasks
+	 * in this layout, so it must not change.
+	 */
+	struct Rq_entry
 	{
 
 			int task_id;
 			Task_class task_class;
 			Task_strategy task_strategy;
 			unsigned long long deadline;
-			unsigned long long wcet;
+			unsigned long long wcet;          /* budget in lo mode */
 			unsigned long long inter_arrival;
 			int prio;
 			bool valid;
 			char name[24];
 
 	};
+
+	/*
+	 * Task as clients describe it and the controller analyses it:
+	 * the entry of the kernel plus parameters only the analysis
+	 * uses. It is no aggregate, fields that are not set have to be
+	 * value-initialized, e.g. Rq_task t { }.
+	 */
+	struct Rq_task : Rq_entry
+	{
+
+			unsigned long long wcet_hi = 0;   /* budget of hi tasks after a mode switch, 0 if equal to wcet */
+			unsigned long long jitter = 0;    /* maximum release jitter, 0 if released strictly periodic */
+			unsigned long long blocking = 0;  /* maximum blocking by lower priority tasks on shared resources */
+
+	};
 }
 
 #endif /* _INCLUDE__RQ_TASK__RQ_TASK_H_ */
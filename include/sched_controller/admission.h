@@ -0,0 +1,43 @@
+/*
+ * \brief  Budgeted admission requests and their results
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * A client on a real-time path can bound the analysis time of
+ * its admission request. If the exact test does not finish
+ * within the budget, the controller answers conservatively,
+ * either with a rejection or with a provisional admission
+ * that is completed in the background, see the budget_verdict
+ * attribute of the config.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__ADMISSION_H_
+#define _INCLUDE__SCHED_CONTROLLER__ADMISSION_H_
+
+namespace Sched_controller
+{
+
+	/*
+	 * Limits of one admission, 0 is unbounded
+	 */
+	struct Admission_budget
+	{
+		unsigned long iterations;  /* fixed-point iterations of the kernels */
+		unsigned long long cycles; /* timestamp ticks, like the latency statistics */
+	};
+
+	struct Admission_result
+	{
+		enum Verdict { ADMITTED, REJECTED, PROVISIONAL };
+
+		int verdict;
+		int status;                     /* return value of enq, 0 if enqueued */
+		bool exhausted;                 /* the budget ran out before the test finished */
+		unsigned long iterations;       /* fixed-point iterations spent */
+		unsigned long long lower_bound; /* response time reached when the budget ran out, 0 otherwise */
+		unsigned long long upper_bound; /* bound of Bini et al. for the task, ~0 if not applicable */
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__ADMISSION_H_ */
@@ -0,0 +1,137 @@
+/*
+ * \brief  Parallel evaluation of the candidate cores of a task
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * When a task may go to any of several cores, the admission tests
+ * of the candidate cores are independent of each other. The pool
+ * evaluates them concurrently, one worker thread per core, each
+ * pinned to its core via the CPU session. The workers only read
+ * snapshots of the run queues that the controller takes before an
+ * evaluation, so they never touch the live run queues. Each worker
+ * owns its Sched_alg, the kernels keep state between calls. With
+ * zero workers, the default, the candidates are evaluated one after
+ * the other in the calling thread. The headroom that ranks the
+ * admissible cores is left to the caller, which caches it per core.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__ADMISSION_POOL_H_
+#define _INCLUDE__SCHED_CONTROLLER__ADMISSION_POOL_H_
+
+#include <vector>
+#include <base/semaphore.h>
+#include <base/thread.h>
+
+#include "sched_controller/rq_view.h"
+#include "sched_controller/sched_alg.h"
+#include "rq_task/rq_task.h"
+
+namespace Sched_controller
+{
+
+	class Admission_pool
+	{
+
+		public:
+
+			/*
+			 * Admission test of a candidate core, see Sched_controller::_admit
+			 */
+			enum class Test { none, fp, edf, amc };
+
+			struct Verdict
+			{
+				int core;                     /* set by the caller */
+				bool admissible;              /* the task passes the test on this core, always for Test::none */
+				unsigned long long headroom;  /* largest wcet that fits at the period of the task, set by the caller */
+			};
+
+		private:
+
+			struct Snapshot
+			{
+				Rq_view view;
+				Rq_util util;
+			};
+
+			class Worker : public Genode::Thread<32*1024>
+			{
+				private:
+
+					Admission_pool &_pool;
+					int _index;
+					bool _stop = false;
+
+				public:
+
+					Genode::Semaphore go;
+					Sched_alg alg;
+
+					/*
+					 * The rings of the tracer have a single producer each,
+					 * the kernels of the workers do not record. The exact
+					 * test of enq is traced as before.
+					 */
+					Worker(Admission_pool &pool, int index)
+					: Genode::Thread<32*1024>("admission_worker"), _pool(pool), _index(index)
+					{
+						alg.record(false);
+					}
+
+					void stop() { _stop = true; go.up(); }
+
+					void entry();
+			};
+
+			std::vector<Snapshot> _snapshots;  /* one per core, taken by the controller */
+			std::vector<Worker*> _workers;
+			Genode::Semaphore _done;
+
+			/* the evaluation in progress, read only for the workers */
+			Rq_task::Rq_task const *_task = nullptr;
+			Test _test = Test::none;
+			std::vector<Verdict> *_verdicts = nullptr;
+
+			/* used if there are no workers */
+			Sched_alg _alg;
+
+			void _evaluate(Sched_alg &alg, Verdict *verdict);
+			void _evaluate_share(Sched_alg &alg, int index, int stride);
+
+		public:
+
+			/*
+			 * Run test for task on a run queue with the given view and
+			 * utilization aggregates, like Sched_controller::_admit
+			 */
+			static bool admissible(Sched_alg &alg, Test test, Rq_task::Rq_task task,
+			                       Rq_view const &view, Rq_util util);
+
+			/*
+			 * Copy the run queue of a core, the snapshot is used
+			 * by all evaluations until the next call
+			 */
+			void snapshot(int core, Rq_view const *view, Rq_util const *util);
+
+			/*
+			 * Run the admission test of task on the cores of verdicts,
+			 * returns when all verdicts are filled in. Worker i
+			 * evaluates the verdicts i, i + workers, ... A core
+			 * without a snapshot is not admissible.
+			 */
+			void evaluate(Rq_task::Rq_task const &task, Test test, std::vector<Verdict> *verdicts);
+
+			int num_workers() const { return _workers.size(); }
+
+			/*
+			 * \param num_cores    number of snapshots
+			 * \param num_workers  threads, worker i is pinned to core i
+			 */
+			Admission_pool(int num_cores, int num_workers);
+			~Admission_pool();
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__ADMISSION_POOL_H_ */
@@ -0,0 +1,71 @@
+/*
+ * \brief  Completion of provisional admissions
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * If the analysis of a budgeted admission runs out of its budget,
+ * the task may be admitted provisionally. The exact test is then
+ * completed by this thread on a snapshot of the run queue, without
+ * a budget. The controller collects the finished jobs and enqueues
+ * the admissible tasks if their run queue has not changed since the
+ * snapshot, otherwise the job is analysed again.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__BACKGROUND_ADMISSION_H_
+#define _INCLUDE__SCHED_CONTROLLER__BACKGROUND_ADMISSION_H_
+
+#include <list>
+#include <base/lock.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+
+#include "sched_controller/admission_pool.h"
+#include "sched_controller/rq_view.h"
+#include "sched_controller/sched_alg.h"
+#include "rq_task/rq_task.h"
+
+namespace Sched_controller
+{
+
+	class Background_admission : public Genode::Thread<32*1024>
+	{
+
+		public:
+
+			struct Job
+			{
+				int core;
+				Rq_task::Rq_task task;
+				Admission_pool::Test test;
+				Rq_view view;     /* snapshot of the run queue */
+				Rq_util util;
+				bool admissible;  /* result, valid once the job is done */
+			};
+
+		private:
+
+			Genode::Lock _lock;         /* protects both lists */
+			Genode::Semaphore _queued;  /* number of jobs in _todo */
+			std::list<Job> _todo;
+			std::list<Job> _done;
+
+			Sched_alg _alg;             /* does not record, see Sched_alg::record() */
+
+			void entry();
+
+		public:
+
+			void submit(Job const &job);
+
+			/*
+			 * Move the finished jobs to the end of done
+			 */
+			void take_done(std::list<Job> *done);
+
+			Background_admission();
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__BACKGROUND_ADMISSION_H_ */
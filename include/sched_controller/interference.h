@@ -0,0 +1,193 @@
+/*
+ * \brief  Interference sum of the response time analysis
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Every fixed-point step of the RTA sums ceil((w + J_j) / T_j) * C_j
+ * over the interfering tasks. With the task fields in the arrays of
+ * an Rq_view, the sum is computed several tasks at a time. The
+ * targets are built for the baseline instruction set, so on x86 the
+ * vector kernels are compiled for their instruction set alone and
+ * chosen at runtime from cpuid:
+ * - AVX2, 4 tasks per step, if the CPU and the kernel support it
+ * - SSE4.1, 2 tasks per step, e.g. not on the default CPU of QEMU
+ * - NEON, 2 tasks per step (AArch64 only, 32-bit NEON has no doubles)
+ * - scalar otherwise, or if SCHED_NO_SIMD is defined
+ * All kernels compute in double like the scalar loop. Every term is
+ * an integer below 2^53, so the sum does not depend on the order and
+ * all kernels return exactly the same result. Times have to be below
+ * 2^52, which holds for any time in us or ns.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__INTERFERENCE_H_
+#define _INCLUDE__SCHED_CONTROLLER__INTERFERENCE_H_
+
+#include <math.h>
+
+#if !defined(SCHED_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SCHED_SIMD_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif !defined(SCHED_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define SCHED_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Sched_controller
+{
+
+	namespace Interference
+	{
+
+		typedef unsigned long long Time;
+
+		inline Time scalar(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			double sum = 0.0;
+			for (int j = 0; j < n; j++)
+				sum += ceil((double)(w + jitter[j]) / (double)period[j]) * (double)wcet[j];
+			return (Time)sum;
+		}
+
+#if defined(SCHED_SIMD_X86)
+
+		/*
+		 * x86 has no unsigned 64-bit to double conversion before AVX-512.
+		 * For v < 2^52, the bits of v in the mantissa of 2^52 give 2^52 + v.
+		 */
+		static const long long MAGIC_BITS = 0x4330000000000000LL;
+		static const double    MAGIC      = 4503599627370496.0; /* 2^52 */
+
+		__attribute__((target("avx2")))
+		inline __m256d _to_double(__m256i v)
+		{
+			__m256i bits = _mm256_or_si256(v, _mm256_set1_epi64x(MAGIC_BITS));
+			return _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(MAGIC));
+		}
+
+		__attribute__((target("avx2")))
+		inline Time avx2(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			__m256i vw = _mm256_set1_epi64x((long long)w);
+			__m256d sum = _mm256_setzero_pd();
+			int j = 0;
+			for (; j + 4 <= n; j += 4) {
+				__m256i c = _mm256_loadu_si256((__m256i const *)(wcet + j));
+				__m256i t = _mm256_loadu_si256((__m256i const *)(period + j));
+				__m256i x = _mm256_add_epi64(vw, _mm256_loadu_si256((__m256i const *)(jitter + j)));
+				__m256d q = _mm256_ceil_pd(_mm256_div_pd(_to_double(x), _to_double(t)));
+				sum = _mm256_add_pd(sum, _mm256_mul_pd(q, _to_double(c)));
+			}
+			double lanes[4];
+			_mm256_storeu_pd(lanes, sum);
+			return (Time)(lanes[0] + lanes[1] + lanes[2] + lanes[3])
+			     + scalar(wcet + j, period + j, jitter + j, n - j, w);
+		}
+
+		__attribute__((target("sse4.1")))
+		inline __m128d _to_double(__m128i v)
+		{
+			__m128i bits = _mm_or_si128(v, _mm_set1_epi64x(MAGIC_BITS));
+			return _mm_sub_pd(_mm_castsi128_pd(bits), _mm_set1_pd(MAGIC));
+		}
+
+		__attribute__((target("sse4.1")))
+		inline Time sse4(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			__m128i vw = _mm_set1_epi64x((long long)w);
+			__m128d sum = _mm_setzero_pd();
+			int j = 0;
+			for (; j + 2 <= n; j += 2) {
+				__m128i c = _mm_loadu_si128((__m128i const *)(wcet + j));
+				__m128i t = _mm_loadu_si128((__m128i const *)(period + j));
+				__m128i x = _mm_add_epi64(vw, _mm_loadu_si128((__m128i const *)(jitter + j)));
+				__m128d q = _mm_ceil_pd(_mm_div_pd(_to_double(x), _to_double(t)));
+				sum = _mm_add_pd(sum, _mm_mul_pd(q, _to_double(c)));
+			}
+			double lanes[2];
+			_mm_storeu_pd(lanes, sum);
+			return (Time)(lanes[0] + lanes[1])
+			     + scalar(wcet + j, period + j, jitter + j, n - j, w);
+		}
+
+		enum Kernel { SCALAR, SSE4, AVX2 };
+
+		/*
+		 * AVX2 also needs the kernel to save the ymm registers,
+		 * i.e. OSXSAVE and the SSE and AVX state in XCR0
+		 */
+		inline Kernel _detect()
+		{
+			unsigned a, b, c, d;
+			if (!__get_cpuid(1, &a, &b, &c, &d))
+				return SCALAR;
+			Kernel kernel = (c & bit_SSE4_1) ? SSE4 : SCALAR;
+
+			if ((c & bit_OSXSAVE) && (c & bit_AVX) && __get_cpuid_max(0, 0) >= 7) {
+				unsigned xcr0, xcr0_hi;
+				__asm__ volatile ("xgetbv" : "=a" (xcr0), "=d" (xcr0_hi) : "c" (0));
+				__cpuid_count(7, 0, a, b, c, d);
+				if ((b & bit_AVX2) && (xcr0 & 6) == 6)
+					kernel = AVX2;
+			}
+			return kernel;
+		}
+
+		inline Kernel kernel()
+		{
+			static Kernel const detected = _detect();
+			return detected;
+		}
+
+		inline Time simd(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			switch (kernel()) {
+			case AVX2: return avx2(wcet, period, jitter, n, w);
+			case SSE4: return sse4(wcet, period, jitter, n, w);
+			default:   return scalar(wcet, period, jitter, n, w);
+			}
+		}
+
+		inline const char *simd_name()
+		{
+			switch (kernel()) {
+			case AVX2: return "avx2";
+			case SSE4: return "sse4.1";
+			default:   return "scalar";
+			}
+		}
+
+#elif defined(SCHED_SIMD_NEON)
+
+		inline Time simd(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			uint64x2_t vw = vdupq_n_u64(w);
+			float64x2_t sum = vdupq_n_f64(0.0);
+			int j = 0;
+			for (; j + 2 <= n; j += 2) {
+				float64x2_t c = vcvtq_f64_u64(vld1q_u64((uint64_t const *)(wcet + j)));
+				float64x2_t t = vcvtq_f64_u64(vld1q_u64((uint64_t const *)(period + j)));
+				float64x2_t x = vcvtq_f64_u64(vaddq_u64(vw, vld1q_u64((uint64_t const *)(jitter + j))));
+				sum = vfmaq_f64(sum, vrndpq_f64(vdivq_f64(x, t)), c);
+			}
+			return (Time)vaddvq_f64(sum) + scalar(wcet + j, period + j, jitter + j, n - j, w);
+		}
+
+		inline const char *simd_name() { return "neon"; }
+
+#else
+
+		inline Time simd(Time const *wcet, Time const *period, Time const *jitter, int n, Time w)
+		{
+			return scalar(wcet, period, jitter, n, w);
+		}
+
+		inline const char *simd_name() { return "scalar"; }
+
+#endif
+
+	}
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__INTERFERENCE_H_ */
@@ -0,0 +1,132 @@
+/*
+ * \brief  Logging of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * SCHED_LOG_LEVEL selects at compile time which messages exist:
+ * 0 none, 1 errors, 2 warnings (default), 3 info, 4 debug.
+ * Messages above the level compile to nothing, their arguments
+ * are not even evaluated. The level is set in the target.mk,
+ * e.g. CC_OPT += -DSCHED_LOG_LEVEL=4.
+ *
+ * Hot paths, i.e. the admission kernels and the run queue
+ * operations, must not format or print. SCHED_HOT() stores the
+ * format string and up to four integer arguments in a ring of
+ * the last Ring::SIZE events and formats them only when the ring
+ * is dumped with SCHED_HOT_DUMP(). Both exist at level 4 only.
+ * The format has to be a string literal that uses 64 bit
+ * conversions (%llu, %lld, %llx) for all of its arguments.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__LOG_H_
+#define _INCLUDE__SCHED_CONTROLLER__LOG_H_
+
+#include <base/printf.h>
+
+#define SCHED_LOG_ERROR   1
+#define SCHED_LOG_WARNING 2
+#define SCHED_LOG_INFO    3
+#define SCHED_LOG_DEBUG   4
+
+#ifndef SCHED_LOG_LEVEL
+#define SCHED_LOG_LEVEL SCHED_LOG_WARNING
+#endif
+
+#if SCHED_LOG_LEVEL >= SCHED_LOG_ERROR
+#define SCHED_ERR(...) PERR(__VA_ARGS__)
+#else
+#define SCHED_ERR(...) do { } while (0)
+#endif
+
+#if SCHED_LOG_LEVEL >= SCHED_LOG_WARNING
+#define SCHED_WRN(...) PWRN(__VA_ARGS__)
+#else
+#define SCHED_WRN(...) do { } while (0)
+#endif
+
+#if SCHED_LOG_LEVEL >= SCHED_LOG_INFO
+#define SCHED_INF(...) PINF(__VA_ARGS__)
+#else
+#define SCHED_INF(...) do { } while (0)
+#endif
+
+#if SCHED_LOG_LEVEL >= SCHED_LOG_DEBUG
+
+#include <trace/timestamp.h>
+
+namespace Sched_controller { namespace Sched_log {
+
+	class Ring
+	{
+		public:
+
+			enum { SIZE = 256, MAX_ARGS = 4 };
+
+		private:
+
+			struct Entry
+			{
+				Genode::Trace::Timestamp time;
+				const char *format;
+				unsigned long long args[MAX_ARGS];
+			};
+
+			Entry _entries[SIZE];
+			unsigned long _next = 0;   /* total number of recorded events */
+			unsigned long _dumped = 0; /* events up to here were dumped */
+
+		public:
+
+			template <typename... ARGS>
+			void record(const char *format, ARGS... args)
+			{
+				static_assert(sizeof...(ARGS) <= MAX_ARGS, "SCHED_HOT takes at most four arguments");
+
+				unsigned long long values[MAX_ARGS + 1] = { (unsigned long long)args..., 0 };
+				Entry &e = _entries[__atomic_fetch_add(&_next, 1, __ATOMIC_RELAXED) % SIZE];
+				e.time = Genode::Trace::timestamp();
+				e.format = format;
+				for (int i = 0; i < MAX_ARGS; i++)
+					e.args[i] = values[i];
+			}
+
+			/**
+			 * Print the events since the last dump, at most SIZE of them
+			 */
+			void dump()
+			{
+				unsigned long next = _next;
+				unsigned long first = (next - _dumped > SIZE) ? next - SIZE : _dumped;
+				if (first != _dumped)
+					PWRN("Sched_log: %lu events were overwritten", first - _dumped);
+
+				for (unsigned long i = first; i < next; i++) {
+					Entry const &e = _entries[i % SIZE];
+					Genode::printf("[%llu] ", (unsigned long long)e.time);
+					Genode::printf(e.format, e.args[0], e.args[1], e.args[2], e.args[3]);
+					Genode::printf("\n");
+				}
+				_dumped = next;
+			}
+	};
+
+	inline Ring &ring()
+	{
+		static Ring inst;
+		return inst;
+	}
+} }
+
+#define SCHED_DBG(...) PDBG(__VA_ARGS__)
+#define SCHED_HOT(format, ...) ::Sched_controller::Sched_log::ring().record(format, ##__VA_ARGS__)
+#define SCHED_HOT_DUMP() ::Sched_controller::Sched_log::ring().dump()
+
+#else
+
+#define SCHED_DBG(...) do { } while (0)
+#define SCHED_HOT(...) do { } while (0)
+#define SCHED_HOT_DUMP() do { } while (0)
+
+#endif
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__LOG_H_ */
@@ -0,0 +1,40 @@
+/*
+ * \brief  Buckets of a log-linear histogram
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Every power of two is split into SUB linear sub-buckets, so a
+ * bucket knows its values to a relative error of at most 1/SUB
+ * in constant space. The quantile sketch of Wcet_estimator and
+ * the latency histogram of test_taskcreator share this layout.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__LOG_HISTOGRAM_H_
+#define _INCLUDE__SCHED_CONTROLLER__LOG_HISTOGRAM_H_
+
+namespace Sched_controller { namespace Log_histogram {
+
+	enum { SUB_BITS = 3, SUB = 1 << SUB_BITS, BUCKETS = 64 * SUB };
+
+	inline unsigned index(unsigned long long v)
+	{
+		if (v < SUB)
+			return v;
+		unsigned log2 = 63 - __builtin_clzll(v);
+		unsigned sub = (v >> (log2 - SUB_BITS)) & (SUB - 1);
+		return (log2 - SUB_BITS + 1) * SUB + sub;
+	}
+
+	/**
+	 * Lower bound of the values of a bucket
+	 */
+	inline unsigned long long floor(unsigned index)
+	{
+		if (index < SUB)
+			return index;
+		unsigned log2 = index / SUB + SUB_BITS - 1;
+		return (1ULL << log2) | ((unsigned long long)(index % SUB) << (log2 - SUB_BITS));
+	}
+} }
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__LOG_HISTOGRAM_H_ */
@@ -0,0 +1,171 @@
+/*
+ * \brief  Recorder of the optimizer inputs
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Every input of Sched_opt is appended to a RAM dataspace:
+ * the calls it receives, the monitoring and RIP snapshots
+ * and the timer values it reads. After every optimization
+ * a digest of the optimizer state is recorded, so a replay
+ * can check that it takes exactly the same decisions.
+ *
+ * The recording starts with a Header, followed by records.
+ * Each record is a Record followed by len bytes of payload,
+ * padded to 8 bytes. All fields have a fixed width, so a
+ * recording of the target can be replayed on the host. If
+ * the dataspace is full, further records are dropped and
+ * counted in the header.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__OPT_RECORDER_H_
+#define _INCLUDE__SCHED_CONTROLLER__OPT_RECORDER_H_
+
+#include <base/stdint.h>
+#include <ram_session/ram_session.h>
+#include <string>
+
+#include "mon_manager/mon_manager.h"
+#include "rq_task/rq_task.h"
+
+namespace Sched_controller
+{
+
+	namespace Opt_trace
+	{
+		enum { MAGIC = 0x54504f53 /* "SOPT" */, VERSION = 1, NAME_LEN = 32 };
+
+		enum { RIP_SIZE = 256 }; /* uint64 entries of the RIP dataspace, rip[0] included */
+
+		enum Type
+		{
+			GOAL = 1,           /* xml of set_goal */
+			ADD_TASK,           /* Task */
+			START_OPTIMIZING,   /* task name */
+			SCHEDULING_ALLOWED, /* int32 result, task name */
+			LAST_JOB_STARTED,   /* task name */
+			TIME,               /* uint64 ms read from the timer */
+			MONITOR,            /* Thread array up to the first foc_id 0 */
+			RIP,                /* uint64 array of rip[0] (foc_id, time) tuples */
+			DIGEST,             /* uint64 Sched_opt::state_digest() */
+			REMOVE_TASK,        /* task name */
+			CHECK_DUE           /* empty name */
+		};
+
+		struct Header
+		{
+			Genode::uint32_t magic;
+			Genode::uint16_t version;
+			Genode::uint16_t num_cores;
+			Genode::uint32_t used;    /* bytes of records behind the header */
+			Genode::uint32_t dropped; /* records that did not fit */
+		};
+
+		struct Record
+		{
+			Genode::uint32_t type;
+			Genode::uint32_t len;
+		};
+
+		struct Task
+		{
+			Genode::uint32_t core;
+			Genode::int32_t  task_id;
+			Genode::int32_t  task_class;
+			Genode::int32_t  task_strategy;
+			Genode::int32_t  prio;
+			Genode::uint32_t reserved;
+			Genode::uint64_t deadline;
+			Genode::uint64_t wcet;
+			Genode::uint64_t wcet_hi;
+			Genode::uint64_t inter_arrival;
+			Genode::uint64_t jitter;
+			Genode::uint64_t blocking;
+			char             name[24];
+		};
+
+		struct Thread
+		{
+			Genode::uint32_t foc_id;
+			Genode::int32_t  prio;
+			Genode::int32_t  core;
+			Genode::uint32_t reserved;
+			Genode::uint64_t execution_time;
+			Genode::uint64_t arrival_time;
+			Genode::uint64_t start_time;
+			Genode::uint64_t exit_time;
+			char             name[NAME_LEN];
+		};
+
+		inline Genode::size_t padded(Genode::size_t len) { return (len + 7) & ~(Genode::size_t)7; }
+
+		/**
+		 * Iterates over the records of a recording
+		 */
+		class Reader
+		{
+			private:
+
+				const char *_pos;
+				const char *_end;
+
+			public:
+
+				Reader(const void *recording)
+				:
+					_pos((const char *)recording + sizeof(Header)),
+					_end(_pos + ((const Header *)recording)->used)
+				{ }
+
+				/*
+				 * \return false at the end of the recording
+				 */
+				bool next(Record *record, const char **payload)
+				{
+					if (_pos + sizeof(Record) > _end)
+						return false;
+					*record = *(const Record *)_pos;
+					*payload = _pos + sizeof(Record);
+					_pos += sizeof(Record) + padded(record->len);
+					return _pos <= _end;
+				}
+		};
+	}
+
+	class Opt_recorder
+	{
+
+		private:
+
+			Genode::Ram_dataspace_capability _ds_cap;
+			Opt_trace::Header *_header;
+			char *_data;
+			Genode::size_t _capacity;
+
+			bool _append(Opt_trace::Type type, const void *a, Genode::size_t a_len,
+			             const void *b = nullptr, Genode::size_t b_len = 0);
+
+		public:
+
+			Opt_recorder(Genode::size_t size, int num_cores);
+			~Opt_recorder();
+
+			void goal(const char *xml);
+			void add_task(unsigned int core, Rq_task::Rq_task const &task);
+			void call(Opt_trace::Type type, std::string const &task_name);
+			void scheduling_allowed(std::string const &task_name, int result);
+			void time(unsigned long long ms);
+			void monitor(Mon_manager::Monitoring_object const *threads, int max_threads);
+			void rip(long long unsigned const *rip);
+			void digest(unsigned long long digest);
+
+			Genode::Dataspace_capability dataspace() { return _ds_cap; }
+
+			/*
+			 * Print the recording as hex lines "opt_trace: ..." to the LOG
+			 */
+			void dump();
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__OPT_RECORDER_H_ */
@@ -0,0 +1,62 @@
+/*
+ * \brief  Single timeout for the check points of the optimizer
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Sched_opt keeps the next check point of every task in a heap and
+ * programs the delay until the earliest one here. The thread takes
+ * it into the clock of its own timer, arms the timer for it
+ * and, when it expires, calls check_due() through the session of the
+ * controller. The optimizer thus only runs in the entrypoint, and
+ * all tasks due at that time are checked with one monitor snapshot.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__OPT_TIMEOUT_H_
+#define _INCLUDE__SCHED_CONTROLLER__OPT_TIMEOUT_H_
+
+#include <base/lock.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+
+#include "sched_controller_session/client.h"
+#include "sched_controller/sched_opt.h"
+
+namespace Sched_controller
+{
+
+	class Opt_timeout : public Check_timeout, public Genode::Thread<8*1024>
+	{
+
+		private:
+
+			Timer::Connection _timer;
+			Genode::Signal_receiver _receiver;
+			Genode::Signal_context _expired;     /* the timer fired */
+			Genode::Signal_context _programmed;  /* the earliest check point changed */
+			Genode::Signal_context_capability _programmed_cap;
+
+			Genode::Lock _lock;                  /* protects _delay */
+			unsigned long long _delay = ~0ULL;   /* as programmed, ~0 if nothing is due */
+			bool _fresh = false;                 /* _delay was programmed since the thread took it */
+
+			unsigned long long _due = ~0ULL;     /* in ms of _timer, only used by the thread */
+
+			Session_client _session;             /* of the controller itself */
+
+			void entry();
+
+		public:
+
+			/*
+			 * Called by Sched_opt in the entrypoint, only signals the thread
+			 */
+			void program(unsigned long long delay_ms) override;
+
+			Opt_timeout(Genode::Capability<Session> session);
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__OPT_TIMEOUT_H_ */
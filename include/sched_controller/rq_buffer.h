@@ -61,6 +61,8 @@
 #include <base/printf.h>
 #include <spec/arm/cpu/atomic.h> /* atomic access to int values on arm CPUs */
 
+#include "sched_controller/log.h"
+
 namespace Sched_controller
 {
 
@@ -91,6 +93,10 @@ namespace Sched_controller
 			int get_num_elements(); //returns the number of elements within the buffer
 			T *get_first_element(); //returns a pointer to the first element from the buffer
 			T *get_last_element(); //return a pointer to the last element from the buffer
+			T *get_element(int);   //returns a pointer to the n-th element counted from the head
+			int clear();           //removes all elements from the buffer
+			int assign(T const *, int); //replaces all elements of the buffer at once
+			int remove(int);       //removes the n-th element, the elements behind it move up, O(n)
 
 			void init_w_shared_ds(Genode::Dataspace_capability);                                /* helper function for createing the Rq_buffer within a shared memory */
 
@@ -114,7 +120,10 @@ namespace Sched_controller
 	template <typename T>
 	void Rq_buffer<T>::init_w_shared_ds(Genode::Dataspace_capability __ds)
 	{
-		Genode::env()->rm_session()->detach(_ds_begin);
+		/* the buffer may be moved to another dataspace, but it is attached once */
+		if (_ds_begin) {
+			Genode::env()->rm_session()->detach(_ds_begin);
+		}
 		_ds=__ds;
 		/*
 		 * Set the size of the buffer and calculate the memory
@@ -177,13 +186,13 @@ namespace Sched_controller
 
 			if (*_window < 1) {
 
-				PERR("The buffer is currently full. Can't insert further elements.");
+				SCHED_ERR("The buffer is currently full. Can't insert further elements.");
 				*_lock = false;
 
 			} else {
 
 				_buf[*_tail] = t; /* insert element at the current free position */
-				PINF("New element inserted to buffer at position %d with pointer %p", *_tail, &_buf[*_tail]);
+				SCHED_HOT("New element inserted to buffer at position %lld", (long long)*_tail);
 				*_tail += 1; /* move the free position one to the right or wrap around */
 
 				/* check if end of array has been reached */
@@ -198,7 +207,7 @@ namespace Sched_controller
 
 		} else {
 
-			PWRN("Buffer locked");
+			SCHED_WRN("Buffer locked");
 			return 2;
 
 		}
@@ -234,7 +243,7 @@ namespace Sched_controller
 
 			if (*_window >= _buf_size) {
 
-				PINF("The buffer is currently empty. Nothing to dequeue.");
+				SCHED_HOT("The buffer is currently empty. Nothing to dequeue.");
 				*t = nullptr; /* returning null pointer so no old data is used by anyone */
 				*_lock = false;
 				return 1;
@@ -255,7 +264,7 @@ namespace Sched_controller
 				return 0;
 			}
 		} else {
-			PWRN("Buffer locked");
+			SCHED_WRN("Buffer locked");
 			return 2;
 		}
 
@@ -266,7 +275,7 @@ namespace Sched_controller
 	T *Rq_buffer<T>::get_first_element()
 	{
 		if (*_window >= _buf_size) {
-			PINF("The buffer is currently empty!");
+			SCHED_HOT("The buffer is currently empty!");
 			return nullptr;
 		}
 		return &_buf[*_head];
@@ -276,12 +285,118 @@ namespace Sched_controller
 	T *Rq_buffer<T>::get_last_element()
 	{
 		if (*_window >= _buf_size) {
-			PINF("The buffer is currently empty!");
+			SCHED_HOT("The buffer is currently empty!");
 			return nullptr;
 		}
 		return (&_buf[*_tail-1]);
 	}
 
+	template <typename T>
+	T *Rq_buffer<T>::get_element(int n)
+	{
+		if (n < 0 || n >= (_buf_size - *_window)) {
+			return nullptr;
+		}
+		return &_buf[(*_head + n) % _buf_size];
+	}
+
+	/**
+	 * Remove all elements, e.g. to rebuild the buffer
+	 * in a different order.
+	 *
+	 * \return 0 buffer cleared
+	 *         2 buffer locked
+	 */
+	template <typename T>
+	int Rq_buffer<T>::clear()
+	{
+		if ( Genode::cmpxchg(_lock, false, true) ) {
+			*_head = 0;
+			*_tail = 0;
+			*_window = _buf_size;
+			*_lock = false;
+			return 0;
+		}
+
+		SCHED_WRN("Buffer locked");
+		return 2;
+	}
+
+	/**
+	 * Replace the content of the buffer with n elements in one
+	 * step, e.g. to rebuild it in a different order. If the
+	 * elements do not fit, the buffer keeps its content.
+	 *
+	 * \param elements  the new content, starting at the head
+	 * \param n         number of elements
+	 *
+	 * \return 0 buffer replaced
+	 *         1 elements do not fit into the buffer
+	 *         2 buffer locked
+	 */
+	template <typename T>
+	int Rq_buffer<T>::assign(T const *elements, int n)
+	{
+		if ( Genode::cmpxchg(_lock, false, true) ) {
+
+			if (n < 0 || n > _buf_size) {
+				*_lock = false;
+				return 1;
+			}
+
+			for (int i = 0; i < n; i++) {
+				_buf[i] = elements[i];
+			}
+			*_head = 0;
+			*_tail = (n < _buf_size) ? n : 0;
+			*_window = _buf_size - n;
+			*_lock = false;
+			return 0;
+		}
+
+		SCHED_WRN("Buffer locked");
+		return 2;
+	}
+
+	/**
+	 * Remove the n-th element counted from the head. The
+	 * elements behind it move one position towards the
+	 * head, so the buffer keeps its order, e.g. the
+	 * priority order the run queue was built in. This
+	 * costs O(n) copies. Moving the last element into the
+	 * gap would be O(1), but the kernel reads the buffer in
+	 * its order and has no notion of holes or tombstones.
+	 *
+	 * \param n position of the element, see get_element()
+	 *
+	 * \return 0 element removed
+	 *         1 no element at position n
+	 *         2 buffer locked
+	 */
+	template <typename T>
+	int Rq_buffer<T>::remove(int n)
+	{
+		if ( Genode::cmpxchg(_lock, false, true) ) {
+
+			if (n < 0 || n >= (_buf_size - *_window)) {
+				*_lock = false;
+				return 1;
+			}
+
+			int num_elements = _buf_size - *_window;
+			for (int i = n; i < num_elements - 1; i++) {
+				_buf[(*_head + i) % _buf_size] = _buf[(*_head + i + 1) % _buf_size];
+			}
+			*_tail = (*_tail > 0) ? *_tail - 1 : _buf_size - 1;
+			*_window += 1;
+			*_lock = false;
+			return 0;
+		}
+
+		SCHED_WRN("Buffer locked");
+		return 2;
+	}
+
 	template <typename T>
 	int Rq_buffer<T>::get_num_elements()
 	{
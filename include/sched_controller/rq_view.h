@@ -0,0 +1,167 @@
+/*
+ * \brief  Analysis view of a run queue
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The schedulability tests only read a few fields of a task,
+ * so a run queue is mirrored in a structure of arrays for
+ * them: one contiguous array per field, sorted from the
+ * highest to the lowest priority. Tasks of equal priority
+ * keep the order in which they were inserted. The view is
+ * updated together with the Rq_buffer and its Rq_util. The
+ * buffer only holds the Rq_entry part shared with the kernel,
+ * the parameters only the analysis uses (wcet_hi, jitter,
+ * blocking) live in the view and in the controller's slots.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__RQ_VIEW_H_
+#define _INCLUDE__SCHED_CONTROLLER__RQ_VIEW_H_
+
+#include <cstring>
+#include <vector>
+
+#include "rq_task/rq_task.h"
+
+namespace Sched_controller
+{
+
+	class Rq_view
+	{
+
+		public:
+
+			struct Name { char str[sizeof(Rq_task::Rq_task::name)]; };
+
+			/* hot fields, read by the kernels */
+			std::vector<unsigned long long> wcet;
+			std::vector<unsigned long long> period;   /* inter_arrival */
+			std::vector<unsigned long long> deadline;
+			std::vector<unsigned long long> jitter;
+			std::vector<unsigned long long> blocking;
+			std::vector<unsigned long long> wcet_hi;  /* budget in hi mode, wcet for lo tasks */
+			std::vector<int> prio;
+			std::vector<unsigned char> hi;            /* task_class is hi */
+
+			/* cold fields, only for results and logs */
+			std::vector<int> task_id;
+			std::vector<Name> name;
+
+			unsigned long generation = 0; /* counts the changes, copies compare equal until one changes */
+
+			int size() const { return prio.size(); }
+
+			/*
+			 * Index at which a task with the given priority is inserted,
+			 * i.e. the number of tasks with the same or a higher priority
+			 */
+			int position(int p) const
+			{
+				int lo = 0, hi_ = size();
+				while (lo < hi_) {
+					int mid = (lo + hi_) / 2;
+					if (prio[mid] >= p)
+						lo = mid + 1;
+					else
+						hi_ = mid;
+				}
+				return lo;
+			}
+
+			/*
+			 * Copy the fields of task to index, which may be size()
+			 */
+			int insert_at(int index, Rq_task::Rq_task const &task)
+			{
+				bool is_hi = task.task_class == Rq_task::Task_class::hi;
+				Name n;
+				std::strncpy(n.str, task.name, sizeof(n.str));
+				n.str[sizeof(n.str) - 1] = 0;
+
+				wcet.insert(wcet.begin() + index, task.wcet);
+				period.insert(period.begin() + index, task.inter_arrival);
+				deadline.insert(deadline.begin() + index, task.deadline);
+				jitter.insert(jitter.begin() + index, task.jitter);
+				blocking.insert(blocking.begin() + index, task.blocking);
+				wcet_hi.insert(wcet_hi.begin() + index, (is_hi && task.wcet_hi > task.wcet) ? task.wcet_hi : task.wcet);
+				prio.insert(prio.begin() + index, task.prio);
+				hi.insert(hi.begin() + index, is_hi);
+				task_id.insert(task_id.begin() + index, task.task_id);
+				name.insert(name.begin() + index, n);
+				generation++;
+				return index;
+			}
+
+			/*
+			 * Insert task at its priority, returns its index
+			 */
+			int insert(Rq_task::Rq_task const &task) { return insert_at(position(task.prio), task); }
+
+			/*
+			 * Append task regardless of its priority, e.g. to collect
+			 * the interfering tasks of an arbitrary priority order
+			 */
+			void push_back(Rq_task::Rq_task const &task) { insert_at(size(), task); }
+
+			/*
+			 * Append task index of another view
+			 */
+			void push_back(Rq_view const &other, int index)
+			{
+				wcet.push_back(other.wcet[index]);
+				period.push_back(other.period[index]);
+				deadline.push_back(other.deadline[index]);
+				jitter.push_back(other.jitter[index]);
+				blocking.push_back(other.blocking[index]);
+				wcet_hi.push_back(other.wcet_hi[index]);
+				prio.push_back(other.prio[index]);
+				hi.push_back(other.hi[index]);
+				task_id.push_back(other.task_id[index]);
+				name.push_back(other.name[index]);
+				generation++;
+			}
+
+			/*
+			 * Index of the task with the priority and the name of
+			 * task, -1 if the view does not hold it
+			 */
+			int find(Rq_task::Rq_task const &task) const
+			{
+				for (int i = position(task.prio) - 1; i >= 0 && prio[i] == task.prio; i--)
+					if (!std::strncmp(name[i].str, task.name, sizeof(name[i].str) - 1))
+						return i;
+				return -1;
+			}
+
+			void erase(int index)
+			{
+				wcet.erase(wcet.begin() + index);
+				period.erase(period.begin() + index);
+				deadline.erase(deadline.begin() + index);
+				jitter.erase(jitter.begin() + index);
+				blocking.erase(blocking.begin() + index);
+				wcet_hi.erase(wcet_hi.begin() + index);
+				prio.erase(prio.begin() + index);
+				hi.erase(hi.begin() + index);
+				task_id.erase(task_id.begin() + index);
+				name.erase(name.begin() + index);
+				generation++;
+			}
+
+			void clear()
+			{
+				wcet.clear(); period.clear(); deadline.clear(); jitter.clear(); blocking.clear();
+				wcet_hi.clear(); prio.clear(); hi.clear(); task_id.clear(); name.clear();
+				generation++;
+			}
+
+			void reserve(int n)
+			{
+				wcet.reserve(n); period.reserve(n); deadline.reserve(n); jitter.reserve(n); blocking.reserve(n);
+				wcet_hi.reserve(n); prio.reserve(n); hi.reserve(n); task_id.reserve(n); name.reserve(n);
+			}
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__RQ_VIEW_H_ */
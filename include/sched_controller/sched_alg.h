@@ -7,39 +7,228 @@
 #ifndef _INCLUDE__SCHED_CONTROLLER__SCHED_ALG_H_
 #define _INCLUDE__SCHED_CONTROLLER__SCHED_ALG_H_
 
+#include <vector>
+
 #include "sched_controller/rq_buffer.h"
+#include "sched_controller/rq_view.h"
 #include "rq_task/rq_task.h"
 
 namespace Sched_controller
 {
+	/*
+	 * Utilization aggregates of one run queue. They are updated on every
+	 * enqueue, so that the utilization based tests only cost O(1).
+	 */
+	struct Rq_util
+	{
+		double utilization;  /* sum of wcet/inter_arrival over all tasks */
+		double hyperbolic;   /* product of (wcet/inter_arrival + 1) over all tasks */
+		int num_tasks;
+		bool rate_monotonic; /* all tasks have D >= T and rate monotonic priorities */
+	};
+
 	class Sched_alg
 	{
 	private:
 		unsigned long long _response_time_old;
 		unsigned long long _response_time;
 
+		Rq_view _all; /* scratch, the analysed tasks together with the new task */
+		Rq_view _hp;  /* scratch, the interfering tasks of one task */
+
+		bool _record = true; /* kernel events go to the tracer and the statistics */
+		int _core = 0;       /* core of the analysed run queue, for the statistics */
+
+		/* analysis budget, see budget() */
+		unsigned long _max_iterations = 0;
+		unsigned long long _max_cycles = 0;
+		unsigned long long _start = 0;
+		unsigned long _iterations = 0;
+		bool _exhausted = false;
+		unsigned long long _partial_bound = 0;
+
 		/*
-		 * Computes the response time for check_task with the first num_elements from rq_buffer and the new_task
+		 * Account one fixed-point iteration, false once the budget is
+		 * used up. bound is the response time reached so far.
 		 */
-		bool _compute_repsonse_time(Rq_task::Rq_task *new_task, int num_elements, Rq_task::Rq_task *check_task);
-		
+		bool _spend(unsigned long long bound);
+
+		/*
+		 * Interference of the tasks [0, num_tasks) on a busy window w,
+		 * i.e. the sum of ceil((w + J_j) / T_j) * C_j
+		 */
+		static unsigned long long _interference(unsigned long long const *wcet, unsigned long long const *period,
+		                                        unsigned long long const *jitter, int num_tasks, unsigned long long w);
+
+		/*
+		 * Computes the response time of the task check of view, or of new_task if check is negative,
+		 * interfered by the first num_hp tasks of view and, if it is not the checked task, new_task
+		 */
+		bool _compute_repsonse_time(Rq_task::Rq_task *new_task, Rq_view const *view, int num_hp, int check);
+
+		/*
+		 * Computes the response time for task check of tasks, interfered by the first num_hp tasks of hp
+		 */
+		bool _response_time_ok(Rq_view const *tasks, int check, Rq_view const *hp, int num_hp);
+
+		/*
+		 * Same for task check of a view sorted by priority, interfered by the
+		 * tasks before it and by the tasks of equal priority after it
+		 */
+		bool _response_time_ok(Rq_view const *tasks, int check);
+
 		/*
-		 * Pointer to the first task in rq_buffer
+		 * AMC-rtb response times of task check in lo mode and, for hi tasks, across a mode switch
 		 */
-		Rq_task::Rq_task *_first_task; 
+		bool _amc_response_time_ok(Rq_view const *tasks, int check, Rq_view const *hp, int num_hp);
+
+		/*
+		 * EDF processor demand of the tasks in [0, t] plus the longest blocking time
+		 */
+		static unsigned long long _edf_demand(Rq_view const *tasks, unsigned long long t);
 
 	public:
 		/*
-		 * Executes the RTA
-		 * Important: The tasks have to be sorted by their priorities within the rq_buffer
+		 * Executes the RTA of view together with new_task
 		 */
-		bool RTA(Rq_task::Rq_task *new_task, Rq_buffer<Rq_task::Rq_task> *rq_buf);
+		bool RTA(Rq_task::Rq_task *new_task, Rq_view const *view);
 		
 		/*
 		 * Does a sufficient schedulability analysis for fp
-		 * Important: The tasks have to be sorted by their priorities within the rq_buffer
 		 */
-		bool fp_sufficient_test(Rq_task::Rq_task *new_task, Rq_buffer<Rq_task::Rq_task> *rq_buf);
+		bool fp_sufficient_test(Rq_task::Rq_task *new_task, Rq_view const *view);
+
+		/*
+		 * Liu and Layland bound, only valid if rate_monotonic is true
+		 */
+		bool liu_layland_test(Rq_task::Rq_task *new_task, Rq_util *util);
+
+		/*
+		 * Hyperbolic bound (Bini et al.), only valid if rate_monotonic is true
+		 */
+		bool hyperbolic_test(Rq_task::Rq_task *new_task, Rq_util *util);
+
+		/*
+		 * Checks if new_task keeps the run queue rate monotonic, i.e. its deadline is
+		 * not shorter than its period and its priority matches the period order
+		 */
+		bool rate_monotonic(Rq_task::Rq_task *new_task, Rq_view const *view);
+
+		/*
+		 * Runs the cheap tests in the order Liu and Layland bound, hyperbolic bound and
+		 * response time upper bound. Only if all of them are inconclusive the exact RTA
+		 * is executed. rate_monotonic has to be the result of rate_monotonic() combined
+		 * with util->rate_monotonic.
+		 */
+		bool fp_admission_test(Rq_task::Rq_task *new_task, Rq_view const *view, Rq_util *util, bool rate_monotonic);
+
+		/*
+		 * Account new_task in the aggregates after it has been enqueued
+		 */
+		void add_util(Rq_util *util, Rq_task::Rq_task *new_task, bool rate_monotonic);
+
+		/*
+		 * Take a departed task out of the aggregates. A run queue that was
+		 * not rate monotonic stays marked as such until it is empty.
+		 */
+		static void remove_util(Rq_util *util, Rq_task::Rq_task const *task);
+		static void reset_util(Rq_util *util);
+
+		/*
+		 * Audsley's optimal priority assignment for the tasks of a run queue and
+		 * new_task. On success, order holds copies of all tasks with rewritten
+		 * priorities, sorted from the highest to the lowest priority. The tasks
+		 * are needed instead of the view, because the copies are complete tasks.
+		 */
+		bool audsley(Rq_task::Rq_task *new_task, std::vector<Rq_task::Rq_task> const *rq_tasks, std::vector<Rq_task::Rq_task> *order);
+
+		/*
+		 * Adaptive mixed-criticality analysis (AMC-rtb) of view together with new_task.
+		 * Lo tasks are guaranteed in lo mode, hi tasks in lo mode and after any lo
+		 * overrun that switches the core to hi mode, where lo tasks are dropped.
+		 */
+		bool amc_rtb(Rq_task::Rq_task *new_task, Rq_view const *view);
+
+		/*
+		 * Exact fp test of the tasks first_check..size-1 of a view and of the
+		 * tasks of equal priority before first_check. Tasks of equal priority
+		 * interfere with each other, as in RTA().
+		 */
+		bool task_set_schedulable(Rq_view const *tasks, int first_check);
+
+		/*
+		 * Worst-case response time of task index of a view including its release
+		 * jitter, interfered by the tasks of higher and of equal priority. 0 if it
+		 * exceeds the deadline.
+		 */
+		unsigned long long response_time(Rq_view const *tasks, int index);
+
+		/*
+		 * EDF test of view together with new_task. If no deadline is shorter than
+		 * the period the utilization bound is exact, otherwise the processor demand
+		 * criterion is checked with QPA (Zhang and Burns).
+		 */
+		bool edf_test(Rq_task::Rq_task *new_task, Rq_view const *view, Rq_util *util);
+
+		/*
+		 * EDF test of a whole task set, the order of the tasks does not matter
+		 */
+		bool edf_schedulable(Rq_view const *tasks);
+
+		/*
+		 * Budget of a task in hi mode
+		 */
+		static unsigned long long wcet_hi(Rq_task::Rq_task *task);
+
+		/*
+		 * Bound the analysis until the next call, 0 is unbounded. Every
+		 * fixed-point iteration of the RTA, AMC and QPA kernels counts,
+		 * cycles are timestamp ticks. Once the budget is used up, the
+		 * tests return false and exhausted() tells that the verdict is
+		 * not exact.
+		 */
+		void budget(unsigned long iterations, unsigned long long cycles);
+		bool exhausted() const { return _exhausted; }
+		unsigned long iterations() const { return _iterations; }
+
+		/*
+		 * Response time that the analysis had reached when the budget
+		 * ran out, a lower bound of the response time of that task
+		 */
+		unsigned long long partial_bound() const { return _partial_bound; }
+
+		/*
+		 * Response time upper bound of new_task by Bini et al., ~0 if
+		 * its higher priority tasks fully utilize the core
+		 */
+		static unsigned long long upper_bound(Rq_task::Rq_task *new_task, Rq_view const *view);
+
+		/*
+		 * C=D splitting (Burns et al.) of a task that fits on no core
+		 * as a whole: the head runs with budget C' at the highest
+		 * priority of one core and a deadline of C' + B + J, its
+		 * response time there, the tail runs the remaining C - C' on
+		 * another core and is released when the head completes. Largest head budget below the wcet of task
+		 * that keeps view schedulable, 0 if there is none.
+		 */
+		unsigned long long cd_head_budget(Rq_task::Rq_task *task, Rq_view const *view);
+
+		/*
+		 * Head on the core of view and tail of task for a head budget
+		 */
+		static void cd_split(Rq_task::Rq_task const &task, unsigned long long budget, Rq_view const *view,
+		                     Rq_task::Rq_task *head, Rq_task::Rq_task *tail);
+
+		/*
+		 * Leave out the trace events and statistics of the kernels, for
+		 * instances that run beside the controller thread
+		 */
+		void record(bool on) { _record = on; }
+
+		/*
+		 * Count the kernel events for the run queue of core
+		 */
+		void core(int core) { _core = core; }
 	};
 }
 
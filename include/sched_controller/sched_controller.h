@@ -13,7 +13,9 @@
 #define _INCLUDE__SCHED_CONTROLLER__SCHED_CONTROLLER_H_
 
 #include <forward_list>
+#include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "mon_manager/mon_manager_connection.h"
@@ -23,22 +25,75 @@
 #include "sched_controller/rq_buffer.h"
 #include "rq_task/rq_task.h"
 #include <base/signal.h>
+#include "sched_controller/admission.h"
+#include "sched_controller/admission_pool.h"
+#include "sched_controller/background_admission.h"
 #include "sched_controller/sched_alg.h"
+#include "sched_controller/sensitivity.h"
+#include "sched_controller/stats.h"
+#include "sched_controller/wcet_estimator.h"
 
 #include "sched_controller/sched_opt.h"
 
 namespace Sched_controller
 {
 
+	/*
+	 * How hi tasks are admitted: with the priority supplied by the
+	 * client or with Audsley's optimal priority assignment, which may
+	 * rewrite the priorities of the whole run queue.
+	 */
+	enum class Admission_mode { fixed, audsley };
+
 	struct Runqueue {
 
 		Rq_task::Task_class _task_class;
 		Rq_task::Task_strategy _task_strategy;
-		int rq_buffer;
+		int rq_buffer;  /* Rq_buffer and pcore, -1 if the run queue was destroyed */
+		int num_tasks;
+		bool on_demand; /* created for a task, destroyed with its last task */
+
+	};
+
+	/*
+	 * Position of a task in the Rq_buffer of its core and its run queue
+	 */
+	struct Rq_slot {
+
+		int position;
+		int runqueue;         /* index in Sched_controller::_runqueue, -1 if none */
+		Rq_task::Rq_task task; /* as enqueued, with the parameters the kernel does not see */
+
+	};
+
+	/*
+	 * Task that was split over two run queues, see Sched_alg::cd_split()
+	 */
+	struct Split_task {
+
+		int head_core;
+		Rq_task::Rq_task head;
+		int tail_core;
+		Rq_task::Rq_task tail;
 
 	};
 
-	class Sched_controller
+	/*
+	 * Run queue of the kernel as mirrored in an Rq_buffer, see update_rq_buffer()
+	 */
+	struct Rq_mirror {
+
+		bool synced = false;                          /* false until the next full rebuild */
+		std::vector<std::pair<int, int>> list;        /* foc_id, prio as of the last update */
+		std::unordered_map<int, std::string> names;   /* foc_id -> task name */
+		std::unordered_map<std::string, int> jobs;    /* task name -> deployed threads */
+		std::unordered_set<int> counted;              /* foc_ids that are accounted in jobs */
+		std::unordered_set<std::string> pending;      /* admitted since the last update */
+		std::vector<std::string> committed;           /* priority order of the last rewrite, checked by the rebuild */
+
+	};
+
+	class Sched_controller : public Departure_handler
 	{
 
 		private:
@@ -47,18 +102,27 @@ namespace Sched_controller
 			Sync::Connection sync;
 			Timer::Connection _timer;
 			Genode::Dataspace_capability mon_ds_cap;
+			Mon_manager::Monitoring_object *_mon_threads = nullptr;           /* mon_ds_cap, attached once */
 			std::vector<Genode::Dataspace_capability> sync_ds_cap_vector;
 			Genode::Dataspace_capability sync_ds_cap;
 			Genode::Dataspace_capability rq_ds_cap;
 			Genode::Dataspace_capability dead_ds_cap;
 			int* rqs;
-			int _num_rqs = 128;
 			int _num_pcores = 0;
 			int _num_cores = 0;
 			Pcore *_pcore;                                                    /* Array of pcores */
-			Runqueue *_runqueue;                                              /* Array of runqueues */
-			std::unordered_multimap<Pcore*, Runqueue*> _pcore_rq_association; /* which pcore hosts which rq */
-			Rq_buffer<Rq_task::Rq_task> *_rqs; /* array of ring buffers (Rq_buffer with fixed size) */
+			enum { NUM_KINDS = 4 };                                           /* task classes x task strategies */
+			std::vector<Runqueue> _runqueue;                                  /* run queues, destroyed ones are reused */
+			std::vector<int> _free_runqueues;                                 /* indices of destroyed run queues */
+			std::vector<int> _rq_index;                                       /* (pcore, class, strategy) -> run queue, -1 if none */
+			std::vector<int> _rqs_of_kind[NUM_KINDS];                         /* (class, strategy) -> run queues */
+			std::vector<int> _rqs_on_pcore;                                   /* number of run queues per pcore */
+			Rq_buffer<Rq_task::Rq_entry> *_rqs; /* array of ring buffers (Rq_buffer with fixed size) */
+			Rq_util *_rq_util;                 /* utilization aggregates, one per ring buffer */
+			Rq_view *_rq_view;                 /* analysis view, one per ring buffer */
+			Rq_view *_rq_estimate;             /* lo tasks with their estimated wcet, only to place lo tasks */
+			std::vector<std::unordered_map<std::string, Rq_slot>> _slots; /* per ring buffer: task name -> position */
+			std::vector<Rq_mirror> _mirror;    /* kernel run queue, one per ring buffer */
 			Genode::Signal_receiver rec;
 			Genode::Signal_context rec_context;
 			Genode::Trace::Execution_time idlelast0;
@@ -67,14 +131,61 @@ namespace Sched_controller
 			Genode::Trace::Execution_time idlelast3;
 			std::unordered_map<std::string, Rq_task::Rq_task> task_map;
 			Sched_opt *_optimizer;
+			Sched_sensitivity *_sensitivity;                                  /* cached slack and headroom per run queue */
+			Sched_sensitivity *_estimate_sensitivity = nullptr;               /* headroom of _rq_estimate, nullptr if off */
+			Admission_pool *_pool;                                            /* evaluates the candidate cores of allocate_task */
+			int _allocation_workers = 0;                                      /* threads of the pool, -1 for one per core */
+			bool _provisional_admission = false;                              /* admit provisionally if the budget runs out */
+			Background_admission *_background = nullptr;                     /* completes the provisional admissions */
+			std::unordered_map<std::string, Admission_result> _provisional;   /* task name -> result until it is polled */
+			enum { MAX_FINISHED = 64 };                                       /* final results kept for admission_result */
+			std::list<std::string> _finished;                                 /* tasks with a final result, the oldest first */
+			bool _semi_partitioned = false;                                   /* split tasks that fit on no core */
+			std::unordered_map<std::string, Split_task> _split;               /* task name -> portions of a split task */
+			bool _wcet_estimation = false;                                    /* place lo tasks by their estimated wcet */
+			Wcet_estimator::Config _wcet_config;
+			Wcet_estimator *_estimator = nullptr;                             /* fed by the optimizer, nullptr if off */
+			Admission_mode _admission_mode = Admission_mode::fixed;
+			bool _mixed_criticality = false;                                  /* analyse hi and lo tasks with AMC-rtb */
+			Genode::size_t _opt_trace_size = 0;                               /* 0 if the optimizer inputs are not recorded */
+			Opt_recorder *_opt_recorder = nullptr;
+			Genode::size_t _trace_size = 0;                                   /* 0 if tracing is off, see Sched_trace */
+			Sched_stats::Stats *_stats = nullptr;                             /* counters, always on */
 			
 			
 			int _set_num_pcores();
 			int _init_rqs(int);
 			int _init_pcores();
 			int _init_runqueues();
-
-			int deq(int, Rq_task::Rq_task**);
+			void _read_config();
+			int _rewrite_rq(int, std::vector<Rq_task::Rq_task>*);
+			void _check_committed_order(int);
+			int _admission(int, Rq_task::Rq_task, bool);
+			void _count_verdict(int, int);
+			int _admit(int, Rq_task::Rq_task, bool);
+			int _commit(int, Rq_task::Rq_task, bool);
+			Admission_pool::Test _test_of(Rq_task::Rq_task const &);
+			void _complete_admissions();
+			Rq_task::Rq_task _effective(Rq_task::Rq_task);
+			void _account(int, Rq_task::Rq_task, bool);
+			void _reset_analysis(int);
+			void _invalidate(int);
+			void _apply_wcet_estimates();
+			int _enq(int, Rq_task::Rq_task const &);
+			void _occupy(int, Rq_task::Rq_task const &, int);
+			void _index_slots(int);
+			void _clear_slots(int);
+			Rq_task::Rq_task _task_at(int, int);
+			void _tasks_of(int, std::vector<Rq_task::Rq_task>*);
+			int _host_runqueue(int, Rq_task::Rq_task const &);
+			static int _kind(Rq_task::Task_class, Rq_task::Task_strategy);
+			static int _rq_key(int, Rq_task::Task_class, Rq_task::Task_strategy);
+			int _dequeue(int, std::string const &);
+			int _release(std::string const &);
+			bool _deployed_task(int, std::string const &, Rq_task::Rq_task *);
+			void _count_rq_error(int, int);
+
+			int deq(int, Rq_task::Rq_entry**);
 			void the_cycle();
 			
 
@@ -83,10 +194,19 @@ namespace Sched_controller
 		public:
 
 			int enq(int, Rq_task::Rq_task);
-			void allocate_task(Rq_task::Rq_task);
-			void task_to_rq(int, Rq_task::Rq_task*);
+			Admission_result admit(int, Rq_task::Rq_task, Admission_budget);
+			Admission_result admission_result(std::string task_name);
+			int remove_task(std::string task_name);
+			void departed(std::string const &task_name, Cause_of_death cause) override;
+			int allocate_task(Rq_task::Rq_task);
+			int task_to_rq(int, Rq_task::Rq_task*);
+			void evaluate_cores(Rq_task::Rq_task*, std::vector<Admission_pool::Verdict>*);
+			bool semi_partitioned() { return _semi_partitioned; }
+			int split_task(Rq_task::Rq_task*, std::vector<int> const &);
 			int get_num_rqs();
 			void which_runqueues(std::vector<Runqueue>*, Rq_task::Task_class, Rq_task::Task_strategy);
+			int create_runqueue(int pcore, Rq_task::Task_class, Rq_task::Task_strategy, bool on_demand = false);
+			bool destroy_runqueue(int index);
 			double get_utilization(int);
 			std::forward_list<Pcore*> get_unused_cores();
 			void init_ds(int num_rqs, int num_cores);
@@ -94,9 +214,16 @@ namespace Sched_controller
 			int are_you_ready();
 			int get_num_cores();
 			int update_rq_buffer(int core);
+			unsigned long long get_headroom(int core, unsigned long long period);
+			long long get_wcet_slack(std::string task_name);
 			
 			// functions for optimization control
 			Sched_opt* get_optimizer();
+			Genode::Dataspace_capability get_opt_trace();
+			void dump_opt_trace();
+			Genode::Dataspace_capability get_trace();
+			Genode::Dataspace_capability get_stats_ds();
+			Sched_stats::Core_stats get_stats(int core);
 			
 
 			Sched_controller();
@@ -15,6 +15,8 @@
 
 #include <timer_session/connection.h>
 #include "mon_manager/mon_manager.h"
+#include "sched_controller/opt_recorder.h"
+#include "sched_controller/wcet_estimator.h"
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,6 +41,20 @@ namespace Sched_controller {
 		Cause_of_death		cause_of_death;
 	};
 	
+	// notified when the optimizer removes a task, e.g. to reclaim its capacity
+	struct Departure_handler
+	{
+		virtual void departed(std::string const &task_name, Cause_of_death cause) = 0;
+		virtual ~Departure_handler() { }
+	};
+	
+	// programs the single timeout of the optimizer, which calls Sched_opt::check_due() when it expires
+	struct Check_timeout
+	{
+		virtual void program(unsigned long long delay_ms) = 0; // from now on, ~0 if nothing is due
+		virtual ~Check_timeout() { }
+	};
+	
 	// this struct is used to determine the job corresponding to the thread at the rip list
 	struct Newest_job
 	{
@@ -72,6 +88,7 @@ namespace Sched_controller {
 		std::vector<std::string> competitor;
 		unsigned int 		id_related;
 		Newest_job		newest_job;// used for rip list
+		unsigned long long	next_check; // due time of its entry in the check heap, ~0 if it has none
 		
 		
 		// attributes for optimization
@@ -84,6 +101,16 @@ namespace Sched_controller {
 	class Sched_opt {
 		
 		private:
+			// next check point of a task, the entry is stale if the task's next_check differs
+			struct Check
+			{
+				unsigned long long	due;
+				std::string		task;
+				
+				bool operator > (Check const &other) const { return due > other.due; }
+			};
+			
+
 			Mon_manager::Connection*				_mon_manager;
 			Mon_manager::Monitoring_object*				_threads;
 			Genode::Dataspace_capability				_mon_ds_cap;
@@ -103,13 +130,28 @@ namespace Sched_controller {
 			Timer::Connection					timer;
 			int							query_intervall;
 			
+			Opt_recorder*						_recorder; // nullptr if the inputs are not recorded
+			Wcet_estimator*						_estimator; // nullptr if execution times are not estimated
+			Departure_handler*					_departure; // nullptr if nobody is notified
+			
+			std::vector<Check>					_checks; // min-heap by due time
+			Check_timeout*						_timeout; // nullptr if check_due() is only called by start_optimizing()
+			unsigned long long					_programmed; // due time of the programmed timeout
 			
+			// all inputs of the optimizer pass these functions, so they can be recorded
+			unsigned long long _elapsed_ms();
+			void _update_info();
+			void _update_dead();
+			int _scheduling_allowed(std::string task_name);
 			
 			void _query_monitor(std::string task_str, unsigned long long current_time);
+			void _schedule_check(std::string task_str);
+			void _process_due();
+			void _program_timeout();
 			void _task_executed(std::string task_str, unsigned int thread_nr, bool set_to_schedules);
 			void _task_not_executed(std::string task_str);
 			void _deadline_reached(std::string task_str);
-			void _remove_task(std::string task_str, unsigned int foc_id, Cause_of_death cause);
+			void _remove_task(std::string task_str, unsigned int foc_id, Cause_of_death cause, bool report = true);
 			
 			// private setter
 			void _set_newest_job(std::string task_str, unsigned int thread_nr);
@@ -125,12 +167,36 @@ namespace Sched_controller {
 			void set_goal(Genode::Ram_dataspace_capability);
 			void start_optimizing(std::string task_name);
 			
+			// process every task whose check point has passed, with one monitor snapshot
+			void check_due();
+			
+			// earliest check point of all tasks, ~0 if there is none
+			unsigned long long next_check();
+			
+			// program timeout with the earliest check point whenever it changes, nullptr stops it
+			void on_timeout(Check_timeout *timeout);
+			
 			void add_task(unsigned int core, Rq_task::Rq_task task); // add task to task array (info from sched_controller that this task has been enqueued)
 			
 			// these functions are called by the taskloader
 			int scheduling_allowed(std::string task_name);
 			void last_job_started(std::string task_name);
 			
+			// the task was removed from its run queue, forget it as if it was killed
+			void remove_task(std::string task_name);
+			
+			// record all inputs from now on, nullptr stops recording
+			void record(Opt_recorder *recorder);
+			
+			// feed the execution times of finished jobs to estimator, nullptr stops it
+			void estimate(Wcet_estimator *estimator);
+			
+			// notify handler about every task the optimizer removes on its own, nullptr stops it
+			void on_departure(Departure_handler *handler);
+			
+			// hash over the state of all tasks, independent of the order of _tasks
+			unsigned long long state_digest();
+			
 			
 			Sched_opt(int sched_num_cores, Mon_manager::Connection *mon_manager, Mon_manager::Monitoring_object *sched_threads, Genode::Dataspace_capability mon_ds_cap, Genode::Dataspace_capability dead_ds_cap);
 			~Sched_opt();
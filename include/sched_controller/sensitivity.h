@@ -0,0 +1,75 @@
+/*
+ * \brief  Sensitivity analysis of the run queues
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Beyond the yes/no verdict of the RTA, the sensitivity
+ * analysis tells how close a run queue is to saturation:
+ * - the WCET slack of a task is the largest amount its
+ *   wcet may grow while the run queue stays schedulable
+ * - the headroom of a run queue for a period T is the
+ *   largest wcet of a new task with period and deadline
+ *   T that still fits at the lowest priority
+ * Both are found by bisection over the RTA kernel and
+ * cached per run queue. The cache of a run queue is
+ * dropped whenever the run queue changes, the other
+ * run queues keep their results.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__SENSITIVITY_H_
+#define _INCLUDE__SCHED_CONTROLLER__SENSITIVITY_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "sched_controller/rq_view.h"
+#include "sched_controller/sched_alg.h"
+#include "rq_task/rq_task.h"
+
+namespace Sched_controller
+{
+
+	class Sched_sensitivity
+	{
+
+		private:
+
+			struct Rq_cache
+			{
+				bool slack_valid;
+				std::unordered_map<std::string, unsigned long long> wcet_slack;  /* task name -> slack */
+				std::unordered_map<unsigned long long, unsigned long long> headroom; /* period -> max wcet */
+			};
+
+			Sched_alg _alg;              /* own instance, the kernels keep state */
+			std::vector<Rq_cache> _cache; /* one cache per run queue */
+
+			Rq_view _tasks;               /* copy of the analysed run queue, the wcets are varied */
+
+			void _compute_slack(int rq, Rq_view const *view);
+
+		public:
+
+			/*
+			 * Drop the cached results of a run queue after it changed
+			 */
+			void invalidate(int rq);
+
+			/*
+			 * Slack of the task with the given name, -1 if the task is not in the run queue
+			 */
+			long long wcet_slack(int rq, Rq_view const *view, std::string name);
+
+			/*
+			 * Largest wcet of a new task with the given period that fits into the run queue
+			 */
+			unsigned long long headroom(int rq, Rq_view const *view, unsigned long long period);
+
+			Sched_sensitivity(int num_rqs);
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__SENSITIVITY_H_ */
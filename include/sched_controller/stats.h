@@ -0,0 +1,146 @@
+/*
+ * \brief  Statistics of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The controller counts per core how many tasks it admitted and
+ * rejected, how often the run queue was locked or full, how many
+ * deadline misses the optimizer handled and how long admissions
+ * and RTA runs took. The counters live in a RAM dataspace of the
+ * controller. The stats RPC copies them into a second dataspace and
+ * hands out that one, so a client cannot change the counters.
+ * get_stats returns a copy of the counters of one core.
+ *
+ * Counters are updated with relaxed atomics, so a reader sees each
+ * counter consistent, but not all counters of a core at the same
+ * instant. The statistics are always on.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__STATS_H_
+#define _INCLUDE__SCHED_CONTROLLER__STATS_H_
+
+#include <base/stdint.h>
+#include <ram_session/ram_session.h>
+#include <trace/timestamp.h>
+
+namespace Sched_controller { namespace Sched_stats {
+
+	enum { MAGIC = 0x54535343 /* "CSST" */, VERSION = 1 };
+
+	/*
+	 * Latencies in cycles of Trace::timestamp(). Bucket 0 counts
+	 * latencies below 2^(FIRST_BUCKET_LOG2 + 1), bucket i those in
+	 * [2^(FIRST_BUCKET_LOG2 + i), 2^(FIRST_BUCKET_LOG2 + i + 1)),
+	 * the last bucket everything above.
+	 */
+	enum { BUCKETS = 16, FIRST_BUCKET_LOG2 = 6 };
+
+	inline unsigned bucket(unsigned long long cycles)
+	{
+		unsigned log2 = cycles ? 63 - __builtin_clzll(cycles) : 0;
+		if (log2 <= FIRST_BUCKET_LOG2)
+			return 0;
+		return log2 - FIRST_BUCKET_LOG2 < BUCKETS ? log2 - FIRST_BUCKET_LOG2 : BUCKETS - 1;
+	}
+
+	/**
+	 * Lower bound of a bucket in cycles
+	 */
+	inline unsigned long long bucket_floor(unsigned bucket)
+	{
+		return bucket ? 1ULL << (FIRST_BUCKET_LOG2 + bucket) : 0;
+	}
+
+	struct Core_stats
+	{
+		Genode::uint32_t core;
+		Genode::uint32_t num_cores;
+		Genode::uint32_t admitted;
+		Genode::uint32_t rejected;
+		Genode::uint32_t rq_locked;       /* Rq_buffer returned "locked" */
+		Genode::uint32_t rq_full;         /* Rq_buffer returned "full" */
+		Genode::uint32_t sufficient;      /* admissions decided by a sufficient bound */
+		Genode::uint32_t rta;             /* runs of the exact RTA */
+		Genode::uint32_t deadline_misses; /* handled by the optimizer */
+		Genode::uint32_t deploys;         /* run queue updates from the kernel */
+		Genode::uint32_t admission_hist[BUCKETS];
+		Genode::uint32_t rta_hist[BUCKETS];
+	};
+
+	struct Header
+	{
+		Genode::uint32_t magic;
+		Genode::uint16_t version;
+		Genode::uint16_t num_cores;
+	};
+
+	inline void inc(Genode::uint32_t &counter)
+	{
+		__atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+	}
+
+	/**
+	 * Writer side, owned by the controller
+	 */
+	class Stats
+	{
+		private:
+
+			Genode::Ram_dataspace_capability _ds_cap;
+			Header *_header;
+			Core_stats *_cores;
+			Genode::Ram_dataspace_capability _copy_cap; /* handed out by publish() */
+			Header *_copy;
+
+		public:
+
+			Stats(int num_cores);
+			~Stats();
+
+			/**
+			 * Copy all counters into the dataspace of the clients
+			 */
+			Genode::Dataspace_capability publish();
+
+			/**
+			 * Counters of a core, nullptr for an invalid core
+			 */
+			Core_stats *at(unsigned core) { return core < _header->num_cores ? &_cores[core] : nullptr; }
+
+			/**
+			 * Copy of the counters of a core, all zero for an invalid core
+			 */
+			Core_stats snapshot(unsigned core);
+	};
+
+	/**
+	 * Statistics of the controller, nullptr outside of it
+	 */
+	inline Stats *&stats()
+	{
+		static Stats *inst = nullptr;
+		return inst;
+	}
+} }
+
+/*
+ * Count an event of a core, events of an invalid core are not counted
+ */
+#define SCHED_STAT_INC(core, counter) \
+	do { \
+		if (::Sched_controller::Sched_stats::Stats *s = ::Sched_controller::Sched_stats::stats()) \
+			if (::Sched_controller::Sched_stats::Core_stats *c = s->at(core)) \
+				::Sched_controller::Sched_stats::inc(c->counter); \
+	} while (0)
+
+/*
+ * Count a latency in cycles into a histogram of a core
+ */
+#define SCHED_STAT_LATENCY(core, hist, cycles) \
+	do { \
+		if (::Sched_controller::Sched_stats::Stats *s = ::Sched_controller::Sched_stats::stats()) \
+			if (::Sched_controller::Sched_stats::Core_stats *c = s->at(core)) \
+				::Sched_controller::Sched_stats::inc(c->hist[::Sched_controller::Sched_stats::bucket(cycles)]); \
+	} while (0)
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__STATS_H_ */
@@ -21,12 +21,13 @@ namespace Sched_controller {
 	{
 
 		private:
+			static int _to_unused_pcore(Sched_controller*, Rq_task::Rq_task*);
 			//int check_task_consistency(Rq_manager::Rq_task);
 			//int get_dependent_core(Rq_manager::Rq_task, Pcore*);
 
 		public:
 			//virtual int allocate_task(Rq_manager::Rq_task, Pcore*) = 0;
-			static void allocate_task(Sched_controller*, Rq_task::Rq_task*);
+			static int allocate_task(Sched_controller*, Rq_task::Rq_task*);
 
 	};
 
@@ -0,0 +1,173 @@
+/*
+ * \brief  Event trace of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Admissions, optimizer decisions and run queue deployments are
+ * recorded as fixed-size binary events, stamped with the cycle
+ * counter of Genode::Trace::timestamp(). There is one ring per
+ * core in a RAM dataspace that is handed out by the trace RPC.
+ *
+ * The controller is the only producer of a ring, a reader, e.g.
+ * sched_trace_reader, the only consumer. The producer owns head,
+ * the consumer owns tail, so the rings work without locks. If a
+ * ring is full, the event is dropped and counted.
+ *
+ * Tracing is off until a Tracer is created, which happens if the
+ * config has a trace size, e.g. <config trace="64K"/>. Until then
+ * SCHED_TRACE() only tests a null pointer.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__TRACE_H_
+#define _INCLUDE__SCHED_CONTROLLER__TRACE_H_
+
+#include <base/stdint.h>
+#include <ram_session/ram_session.h>
+#include <trace/timestamp.h>
+
+namespace Sched_controller { namespace Sched_trace {
+
+	enum { MAGIC = 0x52545343 /* "CSTR" */, VERSION = 1, NAME_LEN = 16 };
+
+	/* core argument of events of the kernels, see Tracer::core() */
+	enum { ANY_CORE = ~0U };
+
+	enum Type
+	{
+		ADMISSION_BEGIN = 1, /* a = prio, b = deadline */
+		SUFFICIENT_TEST,     /* a = accepting bound: 1 Liu-Layland, 2 hyperbolic, 3 Bini, 0 none */
+		RTA_ITERATION,       /* a = response time, b = deadline */
+		ADMISSION_END,       /* a = result of enq, 0 if admitted */
+		DEADLINE_REACHED,    /* a = 1 if a cause task was found */
+		SET_TO_SCHEDULE,     /* a = to_schedule of the task */
+		RESET_VALUES,        /* a = value of the task on its core */
+		DEPLOY_BEGIN,        /* a = run queue */
+		DEPLOY_END,          /* a = run queue, b = number of tasks */
+		NUM_TYPES
+	};
+
+	inline const char *type_name(unsigned type)
+	{
+		static const char *names[NUM_TYPES] = {
+			"?", "admission", "sufficient_test", "rta_iteration", "admission",
+			"deadline_reached", "set_to_schedule", "reset_values", "deploy", "deploy" };
+		return type < NUM_TYPES ? names[type] : names[0];
+	}
+
+	struct Event
+	{
+		Genode::uint64_t cycles;
+		Genode::uint16_t type;
+		Genode::uint16_t core;
+		Genode::int32_t  task_id;
+		Genode::uint64_t a;
+		Genode::uint64_t b;
+		char             name[NAME_LEN];
+	};
+
+	struct Header
+	{
+		Genode::uint32_t magic;
+		Genode::uint16_t version;
+		Genode::uint16_t num_cores;
+		Genode::uint32_t ring_size; /* events per ring, a power of two */
+		Genode::uint32_t reserved;
+	};
+
+	/*
+	 * Head and tail count events since the start and are
+	 * taken modulo ring_size, each on its own cache line
+	 */
+	struct Ring
+	{
+		Genode::uint32_t head;
+		Genode::uint32_t head_pad[15];
+		Genode::uint32_t tail;
+		Genode::uint32_t tail_pad[15];
+		Genode::uint32_t dropped;
+		Genode::uint32_t dropped_pad[15];
+
+		Event *events() { return (Event *)(this + 1); }
+	};
+
+	inline Genode::size_t ring_bytes(Genode::uint32_t ring_size)
+	{
+		return sizeof(Ring) + ring_size * sizeof(Event);
+	}
+
+	inline Ring *ring(Header *header, unsigned core)
+	{
+		return (Ring *)((char *)(header + 1) + core * ring_bytes(header->ring_size));
+	}
+
+	/**
+	 * Producer side, owned by the controller
+	 */
+	class Tracer
+	{
+		private:
+
+			Genode::Ram_dataspace_capability _ds_cap;
+			Header *_header;
+			unsigned _core = 0; /* ring of events that have no core of their own */
+
+		public:
+
+			/**
+			 * \param size  bytes of the dataspace, split among the cores
+			 */
+			Tracer(Genode::size_t size, int num_cores);
+			~Tracer();
+
+			Genode::Dataspace_capability dataspace() { return _ds_cap; }
+
+			/**
+			 * Select the ring of the events of the sched_alg kernels,
+			 * which do not know the core they analyse
+			 */
+			void core(unsigned core) { _core = core < _header->num_cores ? core : 0; }
+
+			void record(Type type, unsigned core, int task_id, const char *name,
+			            unsigned long long a, unsigned long long b)
+			{
+				unsigned c = core < _header->num_cores ? core : _core;
+				Ring *r = ring(_header, c);
+				Genode::uint32_t head = r->head;
+				if (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= _header->ring_size) {
+					r->dropped++;
+					return;
+				}
+
+				Event &e = r->events()[head & (_header->ring_size - 1)];
+				e.cycles  = Genode::Trace::timestamp();
+				e.type    = type;
+				e.core    = c;
+				e.task_id = task_id;
+				e.a       = a;
+				e.b       = b;
+				int i = 0;
+				for (; name && name[i] && i < NAME_LEN - 1; i++)
+					e.name[i] = name[i];
+				e.name[i] = 0;
+
+				__atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+			}
+	};
+
+	/**
+	 * Tracer of the controller, nullptr if tracing is off
+	 */
+	inline Tracer *&tracer()
+	{
+		static Tracer *inst = nullptr;
+		return inst;
+	}
+} }
+
+#define SCHED_TRACE(type, core, task_id, name, a, b) \
+	do { \
+		if (::Sched_controller::Sched_trace::Tracer *t = ::Sched_controller::Sched_trace::tracer()) \
+			t->record(::Sched_controller::Sched_trace::type, core, task_id, name, a, b); \
+	} while (0)
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__TRACE_H_ */
@@ -0,0 +1,106 @@
+/*
+ * \brief  Online estimation of the WCET of lo tasks
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Clients tend to over-declare the wcet of their tasks. To place
+ * lo tasks, which are best effort, the controller can account an
+ * effective wcet derived from the execution times that Sched_opt
+ * observes per job. The estimate is no budget, so the admission
+ * tests keep the declared wcet. Every task has a log2 histogram with 8 sub-
+ * buckets, i.e. a quantile sketch with a relative error of at most
+ * 12.5% in constant space. The published estimate is the upper
+ * edge of the bucket of an upper confidence bound (99%) of the
+ * configured quantile, times a margin, and never exceeds the
+ * declared wcet. Old jobs are aged out by halving all counts once
+ * a window of jobs is full.
+ *
+ * A job that misses its deadline is right-censored: it was stopped
+ * before it finished, so only a lower bound of its demand is known.
+ * Such jobs are counted above all observed execution times, and as
+ * long as the bound falls among them there is no estimate. Without
+ * them the sketch would only see the jobs that made it in time and
+ * the quantile would be biased low.
+ */
+
+#ifndef _INCLUDE__SCHED_CONTROLLER__WCET_ESTIMATOR_H_
+#define _INCLUDE__SCHED_CONTROLLER__WCET_ESTIMATOR_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sched_controller/log_histogram.h"
+
+namespace Sched_controller
+{
+
+	class Wcet_estimator
+	{
+
+		public:
+
+			struct Config
+			{
+				unsigned quantile = 990;     /* per mille */
+				unsigned margin = 110;       /* percent of the quantile */
+				unsigned min_samples = 100;  /* jobs before an estimate is published */
+				unsigned window = 1 << 16;   /* jobs until the counts are halved */
+			};
+
+		private:
+
+			enum { BUCKETS = Log_histogram::BUCKETS };
+
+			struct Sketch
+			{
+				unsigned counts[BUCKETS];
+				unsigned censored;            /* jobs that missed their deadline */
+				unsigned total;
+				unsigned long long max;
+				unsigned long long published; /* 0 as long as there is no estimate */
+			};
+
+			Config _config;
+			std::unordered_map<std::string, Sketch> _sketches;
+			std::vector<std::string> _changed;  /* tasks whose published estimate changed */
+
+			Sketch &_sketch(std::string const &name);
+			void _age(Sketch &s);
+			void _publish(std::string const &name, Sketch &s);
+			unsigned long long _estimate(Sketch const &s);
+
+		public:
+
+			/*
+			 * Account the execution time of a finished job
+			 */
+			void add(std::string const &name, unsigned long long execution_time);
+
+			/*
+			 * Account a job that missed its deadline
+			 */
+			void add_censored(std::string const &name);
+
+			/*
+			 * Wcet to account for a task, declared if there is no estimate
+			 */
+			unsigned long long effective(std::string const &name, unsigned long long declared) const;
+
+			/*
+			 * Move the names of the tasks with a new estimate to names
+			 */
+			void take_changed(std::vector<std::string> *names);
+
+			/*
+			 * Drop the sketch of a departed task
+			 */
+			void forget(std::string const &name) { _sketches.erase(name); }
+
+			Wcet_estimator(Config const &config) : _config(config) { }
+
+	};
+
+}
+
+#endif /* _INCLUDE__SCHED_CONTROLLER__WCET_ESTIMATOR_H_ */
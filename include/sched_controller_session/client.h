@@ -32,6 +32,21 @@ namespace Sched_controller {
 			return call<Rpc_new_task>(task, core);
 		}
 
+		Admission_result admit(Rq_task::Rq_task task, int core, Admission_budget budget)
+		{
+			return call<Rpc_admit>(task, core, budget);
+		}
+
+		Admission_result admission_result(Genode::String<32> task_name)
+		{
+			return call<Rpc_admission_result>(task_name);
+		}
+
+		int remove_task(Genode::String<32> task_name)
+		{
+			return call<Rpc_remove_task>(task_name);
+		}
+
 		void set_sync_ds(Genode::Dataspace_capability ds_cap)
 		{
 			call<Rpc_set_sync_ds>(ds_cap);
@@ -66,6 +81,50 @@ namespace Sched_controller {
 		{
 			call<Rpc_last_job_started>(task_name);
 		}
+
+		void check_due()
+		{
+			call<Rpc_check_due>();
+		}
+
+		// sensitivity analysis
+		unsigned long long headroom(int core, unsigned long long period)
+		{
+			return call<Rpc_headroom>(core, period);
+		}
+
+		long long wcet_slack(Genode::String<32> task_name)
+		{
+			return call<Rpc_wcet_slack>(task_name);
+		}
+
+		// recording of the optimizer inputs
+		Genode::Dataspace_capability opt_trace()
+		{
+			return call<Rpc_opt_trace>();
+		}
+
+		void dump_opt_trace()
+		{
+			call<Rpc_dump_opt_trace>();
+		}
+
+		// event trace, see sched_controller/trace.h
+		Genode::Dataspace_capability trace()
+		{
+			return call<Rpc_trace>();
+		}
+
+		// statistics, see sched_controller/stats.h
+		Genode::Dataspace_capability stats()
+		{
+			return call<Rpc_stats>();
+		}
+
+		Sched_stats::Core_stats get_stats(int core)
+		{
+			return call<Rpc_get_stats>(core);
+		}
 	};
 }
 
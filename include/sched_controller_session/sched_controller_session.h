@@ -12,8 +12,11 @@
 #include <base/rpc.h>
 #include <string>
 #include <util/string.h>
+#include <dataspace/capability.h>
 
 #include "rq_task/rq_task.h"
+#include "sched_controller/admission.h"
+#include "sched_controller/stats.h"
 
 namespace Sched_controller {
 
@@ -25,26 +28,50 @@ namespace Sched_controller {
 
 		virtual void get_init_status() = 0;
 		virtual int new_task(Rq_task::Rq_task, int core) = 0;
+		virtual Admission_result admit(Rq_task::Rq_task, int core, Admission_budget) = 0;
+		virtual Admission_result admission_result(Genode::String<32>) = 0;
+		virtual int remove_task(Genode::String<32>) = 0;
 		virtual void set_sync_ds(Genode::Dataspace_capability) = 0;
 		virtual int are_you_ready() = 0;
 		virtual int update_rq_buffer(int core) = 0;
 		virtual void optimize (Genode::String<32> task_name) = 0;
+		virtual void check_due() = 0;
 		virtual void set_opt_goal (Genode::Ram_dataspace_capability) = 0;
 		virtual int scheduling_allowed(Genode::String<32>) = 0;
 		virtual void last_job_started(Genode::String<32>) = 0;
+		virtual unsigned long long headroom(int core, unsigned long long period) = 0;
+		virtual long long wcet_slack(Genode::String<32>) = 0;
+		virtual Genode::Dataspace_capability opt_trace() = 0;
+		virtual void dump_opt_trace() = 0;
+		virtual Genode::Dataspace_capability trace() = 0;
+		virtual Genode::Dataspace_capability stats() = 0;
+		virtual Sched_stats::Core_stats get_stats(int core) = 0;
 
 		GENODE_RPC(Rpc_get_init_status, void, get_init_status);
 		GENODE_RPC(Rpc_new_task, int, new_task, Rq_task::Rq_task, int);
+		GENODE_RPC(Rpc_admit, Admission_result, admit, Rq_task::Rq_task, int, Admission_budget);
+		GENODE_RPC(Rpc_admission_result, Admission_result, admission_result, Genode::String<32>);
+		GENODE_RPC(Rpc_remove_task, int, remove_task, Genode::String<32>);
 		GENODE_RPC(Rpc_set_sync_ds, void, set_sync_ds, Genode::Dataspace_capability);
 		GENODE_RPC(Rpc_are_you_ready, int, are_you_ready);
 		GENODE_RPC(Rpc_update_rq_buffer, int, update_rq_buffer, int);
 		GENODE_RPC(Rpc_optimize, void, optimize, Genode::String<32>);
+		GENODE_RPC(Rpc_check_due, void, check_due);
 		GENODE_RPC(Rpc_set_opt_goal, void, set_opt_goal, Genode::Ram_dataspace_capability);
 		GENODE_RPC(Rpc_scheduling_allowed, int, scheduling_allowed, Genode::String<32>);
 		GENODE_RPC(Rpc_last_job_started, void, last_job_started, Genode::String<32>);
+		GENODE_RPC(Rpc_headroom, unsigned long long, headroom, int, unsigned long long);
+		GENODE_RPC(Rpc_wcet_slack, long long, wcet_slack, Genode::String<32>);
+		GENODE_RPC(Rpc_opt_trace, Genode::Dataspace_capability, opt_trace);
+		GENODE_RPC(Rpc_dump_opt_trace, void, dump_opt_trace);
+		GENODE_RPC(Rpc_trace, Genode::Dataspace_capability, trace);
+		GENODE_RPC(Rpc_stats, Genode::Dataspace_capability, stats);
+		GENODE_RPC(Rpc_get_stats, Sched_stats::Core_stats, get_stats, int);
 		
 		
-		GENODE_RPC_INTERFACE(Rpc_get_init_status, Rpc_new_task, Rpc_set_sync_ds, Rpc_are_you_ready, Rpc_update_rq_buffer, Rpc_optimize, Rpc_set_opt_goal, Rpc_scheduling_allowed, Rpc_last_job_started);
+		GENODE_RPC_INTERFACE(Rpc_get_init_status, Rpc_new_task, Rpc_admit, Rpc_admission_result, Rpc_remove_task, Rpc_set_sync_ds, Rpc_are_you_ready, Rpc_update_rq_buffer, Rpc_optimize, Rpc_check_due, Rpc_set_opt_goal, Rpc_scheduling_allowed, Rpc_last_job_started,
+		                     Rpc_headroom, Rpc_wcet_slack, Rpc_opt_trace, Rpc_dump_opt_trace, Rpc_trace,
+		                     Rpc_stats, Rpc_get_stats);
 	};
 }
 
@@ -0,0 +1,116 @@
+/*
+ * \brief  Sampler of the CPU share of the trace subjects
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * A sample reads only the CPU info of the known subjects, one RPC
+ * per subject. The subject list and the RAM info, which changes
+ * slowly, are re-read only every rescan period or when a subject
+ * vanished. Between two samples the sampler computes the execution
+ * time delta and the CPU share of each subject and keeps them in a
+ * bounded history ring, which is emitted as CSV report "samples".
+ */
+
+#ifndef _INCLUDE__SCHED_TMONITOR__SAMPLER_H_
+#define _INCLUDE__SCHED_TMONITOR__SAMPLER_H_
+
+#include <base/stdint.h>
+#include <report_session/connection.h>
+#include <trace_session/connection.h>
+#include <util/string.h>
+
+namespace Sched_tmonitor {
+
+	struct Sampler_config
+	{
+		unsigned max_subjects = 256;
+		unsigned history = 4096;      /* samples kept for the report */
+		unsigned long rescan_ms = 1000;
+		Genode::size_t report_size = 256 * 1024;
+	};
+
+	/*
+	 * One entry of the history ring
+	 */
+	struct Sample
+	{
+		Genode::uint32_t time_ms;
+		Genode::uint32_t subject;     /* trace subject id */
+		Genode::uint64_t delta_us;    /* execution time since the previous sample */
+		Genode::uint16_t share;       /* of one CPU in permille */
+		Genode::uint16_t prio;
+		Genode::uint32_t reserved;
+	};
+
+	class Sampler
+	{
+		private:
+
+			enum { NAME_LEN = 32 };
+
+			struct Subject
+			{
+				Genode::Trace::Subject_id id;
+				unsigned long long exec_us;   /* execution time at the last sample */
+				unsigned prio;
+				Genode::size_t ram_used;
+				unsigned share;               /* permille of the last sample */
+				bool fresh;                   /* no sample yet, delta undefined */
+				char name[NAME_LEN];
+			};
+
+			Genode::Trace::Connection &_trace;
+			Sampler_config _config;
+
+			Genode::Trace::Subject_id *_ids;
+			Subject *_subjects;
+			Subject *_scratch;
+			unsigned _num_subjects = 0;
+			unsigned long _last_rescan_ms = 0;
+			unsigned long _last_sample_ms = 0;
+			bool _rescan_needed = true;
+
+			Sample *_history;
+			unsigned long _next = 0;      /* samples written since the start */
+			unsigned long _reported = 0;  /* samples up to here are in a report */
+
+			Report::Connection _report;
+			char *_report_buf;
+
+			unsigned long _rpcs = 0;      /* trace RPCs of the sampler, its own load */
+
+			void _rescan(unsigned long now_ms);
+			void _push(Sample const &sample);
+
+		public:
+
+			Sampler(Genode::Trace::Connection &trace, Sampler_config const &config);
+			~Sampler();
+
+			/**
+			 * Read the execution time of all subjects
+			 *
+			 * \param now_ms  time of the sample, e.g. Timer::elapsed_ms()
+			 */
+			void sample(unsigned long now_ms);
+
+			/**
+			 * Submit the samples since the last report as CSV, the
+			 * samples that do not fit into report_size are kept for
+			 * the next report
+			 *
+			 * \return number of reported samples
+			 */
+			unsigned long report();
+
+			unsigned num_subjects() const { return _num_subjects; }
+			unsigned long rpcs() const { return _rpcs; }
+
+			/**
+			 * Print the subjects with the largest share of the last sample
+			 */
+			void print_top(unsigned count);
+	};
+}
+
+#endif /* _INCLUDE__SCHED_TMONITOR__SAMPLER_H_ */
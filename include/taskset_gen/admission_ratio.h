@@ -0,0 +1,97 @@
+/*
+ * \brief  Admission ratio of the schedulability tests
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Sweeps the utilization of random task sets and measures for
+ * every test how many sets are accepted and how long a single
+ * admission decision takes. The tasks of a set are admitted
+ * one by one in priority order into an empty run queue, a set
+ * is accepted if all of its tasks are admitted. The partition
+ * test distributes sets with num_cores times the utilization
+ * over num_cores run queues like the Task_allocator does, the
+ * semi_partition test additionally splits a task that fits on
+ * no core over two of them (C=D splitting).
+ */
+
+#ifndef _INCLUDE__TASKSET_GEN__ADMISSION_RATIO_H_
+#define _INCLUDE__TASKSET_GEN__ADMISSION_RATIO_H_
+
+#include <vector>
+
+#include "rq_task/rq_task.h"
+#include "sched_controller/rq_view.h"
+#include "sched_controller/sched_alg.h"
+#include "sched_controller/sensitivity.h"
+#include "taskset_gen/taskset_gen.h"
+
+namespace Taskset_gen
+{
+
+	enum class Test { sufficient, cascade, rta, edf, partition, semi_partition };
+
+	const char *test_name(Test test);
+
+	struct Sweep_config
+	{
+		Params params;
+		double util_min = 0.05;    /* utilization per core */
+		double util_max = 1.0;
+		double util_step = 0.05;
+		unsigned sets_per_step = 100;
+		unsigned num_cores = 4;    /* run queues of the partition test */
+		unsigned seed = 1;
+	};
+
+	struct Sweep_result
+	{
+		Test test;
+		double utilization;       /* utilization per core */
+		unsigned sets;
+		unsigned accepted;
+		unsigned long long mean_ns; /* per admission decision */
+		unsigned long long p99_ns;
+		unsigned long long max_ns;
+	};
+
+	class Admission_ratio
+	{
+
+		public:
+
+			typedef unsigned long long (*Now_ns)();
+			typedef void (*Report)(Sweep_result const &result);
+
+		private:
+
+			Sweep_config _config;
+			Now_ns _now;
+			Generator _gen;
+			Sched_controller::Sched_alg _alg;
+			Sched_controller::Sched_sensitivity _sensitivity;
+
+			std::vector<Sched_controller::Rq_view> _rqs; /* one per core, highest priority first */
+			Sched_controller::Rq_view _scratch;          /* run queue of _fits() */
+			std::vector<double> _util;                   /* utilization per core */
+			std::vector<unsigned long long> _samples;
+
+			bool _admit(Test test, std::vector<Rq_task::Rq_task> &tasks);
+			bool _partition(std::vector<Rq_task::Rq_task> &tasks, bool split);
+			bool _split(Rq_task::Rq_task &task);
+			bool _fits(unsigned core, Rq_task::Rq_task const &task);
+			void _insert(unsigned core, Rq_task::Rq_task const &task);
+			void _clear();
+			Sweep_result _result(Test test, double util, unsigned accepted);
+
+		public:
+
+			Admission_ratio(Sweep_config const &config, Now_ns now);
+
+			/*
+			 * Run the sweep, report is called once per test and utilization step
+			 */
+			void run(Report report);
+	};
+}
+
+#endif /* _INCLUDE__TASKSET_GEN__ADMISSION_RATIO_H_ */
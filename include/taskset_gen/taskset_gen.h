@@ -0,0 +1,140 @@
+/*
+ * \brief  Random task set generator
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Utilizations are drawn with UUniFast (Bini and Buttazzo),
+ * which samples uniformly from all utilization vectors with
+ * the requested sum. If the sum exceeds 1, e.g. for sets
+ * that are partitioned over several cores, UUniFast-Discard
+ * redraws vectors that contain a task with utilization > 1.
+ * Periods are log-uniform within [period_min, period_max],
+ * deadlines are a random fraction of the period and the
+ * priorities are deadline monotonic.
+ */
+
+#ifndef _INCLUDE__TASKSET_GEN__TASKSET_GEN_H_
+#define _INCLUDE__TASKSET_GEN__TASKSET_GEN_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "rq_task/rq_task.h"
+
+namespace Taskset_gen
+{
+
+	struct Params
+	{
+		unsigned num_tasks = 8;
+		double utilization = 0.5;                 /* sum of wcet/inter_arrival */
+		unsigned long long period_min = 10000;
+		unsigned long long period_max = 1000000;
+		unsigned long long period_granularity = 1; /* periods are multiples of it */
+		double deadline_ratio_min = 1.0;           /* deadline = ratio * period */
+		double deadline_ratio_max = 1.0;
+		double hi_share = 1.0;                     /* fraction of hi tasks */
+		Rq_task::Task_strategy strategy = Rq_task::Task_strategy::priority;
+	};
+
+	class Generator
+	{
+
+		private:
+
+			std::mt19937 _gen;
+			std::uniform_real_distribution<double> _uniform { 0.0, 1.0 };
+			unsigned _next_id = 1;
+
+		public:
+
+			Generator(unsigned seed) : _gen(seed) { }
+
+			/**
+			 * UUniFast: n utilizations with sum u
+			 */
+			void uunifast(unsigned n, double u, std::vector<double> *out)
+			{
+				out->clear();
+				double sum = u;
+				for (unsigned i = 1; i < n; i++) {
+					double next = sum * std::pow(_uniform(_gen), 1.0 / (n - i));
+					out->push_back(sum - next);
+					sum = next;
+				}
+				out->push_back(sum);
+			}
+
+			/**
+			 * UUniFast-Discard: like uunifast, but no utilization exceeds 1
+			 *
+			 * \return false if no valid vector was found within max_tries
+			 */
+			bool uunifast_discard(unsigned n, double u, std::vector<double> *out, unsigned max_tries = 1000)
+			{
+				for (unsigned t = 0; t < max_tries; t++) {
+					uunifast(n, u, out);
+					if (std::all_of(out->begin(), out->end(), [] (double v) { return v <= 1.0; }))
+						return true;
+				}
+				return false;
+			}
+
+			unsigned long long log_uniform_period(Params const &p)
+			{
+				double lo = std::log((double)p.period_min);
+				double hi = std::log((double)p.period_max);
+				unsigned long long period = (unsigned long long)std::exp(lo + _uniform(_gen) * (hi - lo));
+				if (p.period_granularity > 1)
+					period -= period % p.period_granularity;
+				return std::max(period, std::max(p.period_granularity, 1ULL));
+			}
+
+			/**
+			 * Generate a task set, sorted from the highest to the lowest priority
+			 *
+			 * \return false if the utilization can not be split into valid tasks
+			 */
+			bool task_set(Params const &p, std::vector<Rq_task::Rq_task> *tasks)
+			{
+				std::vector<double> util;
+				if (!uunifast_discard(p.num_tasks, p.utilization, &util))
+					return false;
+
+				tasks->clear();
+				for (unsigned i = 0; i < p.num_tasks; i++) {
+					Rq_task::Rq_task t { };
+
+					t.task_id = _next_id++;
+					t.task_class = (_uniform(_gen) < p.hi_share) ? Rq_task::Task_class::hi
+					                                             : Rq_task::Task_class::lo;
+					t.task_strategy = p.strategy;
+					t.inter_arrival = log_uniform_period(p);
+					t.wcet = std::max(1ULL, (unsigned long long)std::llround(util[i] * t.inter_arrival));
+					t.wcet_hi = t.wcet;
+
+					double ratio = p.deadline_ratio_min + _uniform(_gen) * (p.deadline_ratio_max - p.deadline_ratio_min);
+					t.deadline = std::max(t.wcet, (unsigned long long)(ratio * t.inter_arrival));
+					t.valid = true;
+					std::snprintf(t.name, sizeof(t.name), "gen%d", t.task_id);
+
+					tasks->push_back(t);
+				}
+
+				/* deadline monotonic priorities */
+				std::stable_sort(tasks->begin(), tasks->end(), [] (Rq_task::Rq_task const &a, Rq_task::Rq_task const &b) {
+					return a.deadline < b.deadline;
+				});
+				for (unsigned i = 0; i < tasks->size(); i++)
+					(*tasks)[i].prio = tasks->size() - i;
+
+				return true;
+			}
+	};
+}
+
+#endif /* _INCLUDE__TASKSET_GEN__TASKSET_GEN_H_ */
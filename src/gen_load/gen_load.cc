@@ -2,48 +2,40 @@
  * \brief  put some load on the machine
  * \author Paul Nieleck
  * \date   2016/09/23
+ *
+ * A periodic task that runs until it is killed, see
+ * gen_load/workload.h for its config.
  */
 
-#include <limits>
-#include <random>
-#include <base/sleep.h>
-#include <timer_session/connection.h>
 #include <base/printf.h>
+#include <os/config.h>
+#include <timer_session/connection.h>
 
-double compute_e()
-{
-
-	double e = 1.0;
-	double kf;
-
-	for (int k = 1; k < 32000000; k++) {
-
-			kf *= (double) k;
-
-		e += (1 / kf);
-
-	}
-
-	return e;
-
-}
+#include "gen_load/workload.h"
 
 int main ()
 {
 
 	static Timer::Connection _timer;
 
-	std::default_random_engine generator;
-	std::uniform_int_distribution<int> distribution(1, std::numeric_limits<int>::max());
-
-	while (true) {
+	Gen_load::Task_params params;
+	params.period_us = 20000000;
+	params.wcet_us   = 100000;
+	params.jobs      = 0;
+	try {
+		params.read(Genode::config()->xml_node());
+	} catch (...) {
+		PWRN("gen_load: no valid config, using the defaults");
+	}
 
-		double e = compute_e();
-		PINF("e = %d", (int) e * 10000000000);
-		_timer.msleep(20000);
+	static Gen_load::Busy_loop loop;
+	loop.calibrate(_timer);
+	PINF("gen_load: busy loop runs %llu iterations per ms, %llu cycles per ms",
+	     loop.iterations_per_ms(), loop.cycles_per_ms());
 
-	}
+	static Gen_load::Workload workload(_timer, loop, params);
+	workload.run();
 
 	return 0;
 
-}
\ No newline at end of file
+}
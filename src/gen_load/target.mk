@@ -1,3 +1,3 @@
 TARGET = gen_load
-SRC_CC = gen_load.cc
-LIBS   = base stdcxx
\ No newline at end of file
+SRC_CC = gen_load.cc workload.cc
+LIBS   = base stdcxx config
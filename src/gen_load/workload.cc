@@ -0,0 +1,165 @@
+/*
+ * \brief  Calibrated periodic workload
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/snprintf.h>
+#include <trace/timestamp.h>
+#include <util/string.h>
+
+#include "gen_load/workload.h"
+
+namespace Gen_load {
+
+	void Task_params::read(Genode::Xml_node node)
+	{
+		period_us    = node.attribute_value("period_us", period_us);
+		wcet_us      = node.attribute_value("wcet_us", wcet_us);
+		deadline_us  = node.attribute_value("deadline_us", deadline_us);
+		jitter_us    = node.attribute_value("jitter_us", jitter_us);
+		offset_us    = node.attribute_value("offset_us", offset_us);
+		jobs         = node.attribute_value("jobs", jobs);
+		report_every = node.attribute_value("report_every", report_every);
+		seed         = node.attribute_value("seed", seed);
+	}
+
+	void Busy_loop::_spin(unsigned long long iterations)
+	{
+		/* a data dependency through all iterations, the sink keeps the result */
+		Genode::uint64_t x = _sink;
+		for (unsigned long long i = 0; i < iterations; i++)
+			x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+		_sink = x;
+	}
+
+	void Busy_loop::calibrate(Timer::Connection &timer, unsigned long window_ms)
+	{
+		for (unsigned long long n = 1 << 16; ; n *= 2) {
+			unsigned long t0 = timer.elapsed_ms();
+			Genode::Trace::Timestamp c0 = Genode::Trace::timestamp();
+			_spin(n);
+			unsigned long t1 = timer.elapsed_ms();
+			Genode::Trace::Timestamp c1 = Genode::Trace::timestamp();
+
+			if (t1 - t0 >= window_ms) {
+				_iterations_per_ms = n / (t1 - t0);
+				_cycles_per_ms = (c1 - c0) / (t1 - t0);
+				if (_cycles_per_ms == 0)
+					_cycles_per_ms = 1;
+				break;
+			}
+		}
+	}
+
+	unsigned long long Busy_loop::now_us() const
+	{
+		/* split, so that the multiplication does not overflow */
+		Genode::Trace::Timestamp t = Genode::Trace::timestamp();
+		return (t / _cycles_per_ms) * 1000 + (t % _cycles_per_ms) * 1000 / _cycles_per_ms;
+	}
+
+	unsigned long long Workload::_jitter()
+	{
+		if (!_params.jitter_us)
+			return 0;
+
+		/* xorshift, the release pattern is reproducible with the seed */
+		_random ^= _random << 13;
+		_random ^= _random >> 17;
+		_random ^= _random << 5;
+		return _random % (_params.jitter_us + 1);
+	}
+
+	void Workload::_report_results()
+	{
+		if (!_report)
+			return;
+
+		unsigned long first = _reported;
+		Genode::size_t len = Genode::snprintf(_report_buf, _report_size,
+		                                      "job,release_us,response_us,deadline_us,missed\n");
+		for (unsigned long job = first; job < _done; job++) {
+			Job_result const &r = _results[job % _params.report_every];
+			Genode::size_t room = _report_size - len;
+			Genode::size_t n = Genode::snprintf(_report_buf + len, room, "%lu,%llu,%llu,%llu,%d\n",
+			                                    job, (unsigned long long)r.release_us,
+			                                    (unsigned long long)r.response_us, _params.deadline(),
+			                                    r.response_us > _params.deadline());
+			if (n + 1 >= room)
+				break;
+			len += n;
+		}
+		_report->submit(len);
+		_reported = _done;
+	}
+
+	void Workload::run()
+	{
+		unsigned long long start = _loop.now_us() + _params.offset_us;
+
+		for (unsigned long k = 0; !_params.jobs || k < _params.jobs; k++) {
+			unsigned long long release = start + k * _params.period_us + _jitter();
+
+			unsigned long long now = _loop.now_us();
+			if (release > now)
+				_timer.usleep(release - now);
+			/* the timer may wake up early, wait for the release in the busy loop */
+			while (_loop.now_us() < release)
+				;
+
+			_loop.run_us(_params.wcet_us);
+
+			unsigned long long response = _loop.now_us() - release;
+			Job_result &r = _results[_done % _params.report_every];
+			r.release_us = release - start;
+			r.response_us = response;
+
+			_done++;
+			if (response > _params.deadline())
+				_misses++;
+			if (response > _max_response_us)
+				_max_response_us = response;
+			_sum_response_us += response;
+
+			if (_done - _reported >= _params.report_every)
+				_report_results();
+		}
+
+		if (_done != _reported)
+			_report_results();
+		PINF("gen_load: %lu jobs, %lu deadline misses, response time max %llu us, mean %llu us",
+		     _done, _misses, _max_response_us, _done ? _sum_response_us / _done : 0);
+	}
+
+	Workload::Workload(Timer::Connection &timer, Busy_loop &loop, Task_params const &params)
+	:
+		_timer(timer),
+		_loop(loop),
+		_params(params),
+		_random(params.seed ? params.seed : 1),
+		_report_size(64 + (params.report_every ? params.report_every : 1) * 64)
+	{
+		if (!_params.report_every)
+			_params.report_every = 1;
+		_results = (Job_result *)Genode::env()->heap()->alloc(_params.report_every * sizeof(Job_result));
+
+		try {
+			_report = new (Genode::env()->heap()) Report::Connection("jobs", _report_size);
+			_report_buf = Genode::env()->rm_session()->attach(_report->dataspace());
+		} catch (...) {
+			PWRN("gen_load: no Report service, the response times of the jobs are not reported");
+		}
+	}
+
+	Workload::~Workload()
+	{
+		if (_report) {
+			Genode::env()->rm_session()->detach(_report_buf);
+			Genode::destroy(Genode::env()->heap(), _report);
+		}
+		Genode::env()->heap()->free(_results, _params.report_every * sizeof(Job_result));
+	}
+}
@@ -1,50 +1,42 @@
 /*
  * \brief  put some load on the machine by using finite tasks
  * \date   2017/10/11
+ *
+ * A periodic task with a finite number of jobs, see
+ * gen_load/workload.h for its config.
  */
- 
-#include <limits>
-#include <random>
-#include <base/sleep.h>
-#include <timer_session/connection.h>
-#include <base/printf.h>
-
-double compute_e()
-{
-
-	double e = 1.0;
-	double kf;
-
-	for (int k = 1; k < 32000000; k++) {
-
-			kf *= (double) k;
-
-		e += (1 / kf);
-
-	}
 
-	return e;
+#include <base/printf.h>
+#include <os/config.h>
+#include <timer_session/connection.h>
 
-}
+#include "gen_load/workload.h"
 
 int main ()
 {
 	PINF("Hi I'm a finite test task!");
-	int num_iterations = 100;
-	
-	static Timer::Connection _timer;
 
-	std::default_random_engine generator;
-	std::uniform_int_distribution<int> distribution(1, std::numeric_limits<int>::max());
+	static Timer::Connection _timer;
 
-	for (int i=0; i < num_iterations; ++i) {
+	Gen_load::Task_params params;
+	params.period_us = 20000000;
+	params.wcet_us   = 100000;
+	params.jobs      = 100;
+	try {
+		params.read(Genode::config()->xml_node());
+	} catch (...) {
+		PWRN("gen_load_finite: no valid config, using the defaults");
+	}
+	if (params.jobs == 0) {
+		PWRN("gen_load_finite: jobs must be finite, using 100");
+		params.jobs = 100;
+	}
 
-		double e = compute_e();
-		int result = (int) e * 10000000000;
-		PINF("e = %d", result);
-		_timer.msleep(20000);
+	static Gen_load::Busy_loop loop;
+	loop.calibrate(_timer);
 
-	}
+	static Gen_load::Workload workload(_timer, loop, params);
+	workload.run();
 
 	PINF("Bye from a finite test task!");
 	return 0;
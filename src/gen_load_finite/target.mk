@@ -1,3 +1,5 @@
 TARGET = gen_load_finite
-SRC_CC = gen_load_finite.cc
-LIBS   = stdcxx
+SRC_CC = gen_load_finite.cc workload.cc
+LIBS   = base stdcxx config
+
+vpath workload.cc $(PRG_DIR)/../gen_load
@@ -0,0 +1,125 @@
+/*
+ * \brief  Parallel evaluation of the candidate cores of a task
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+
+#include "sched_controller/admission_pool.h"
+#include "sched_controller/log.h"
+
+namespace Sched_controller
+{
+
+	void Admission_pool::Worker::entry()
+	{
+		while (true) {
+			go.down();
+			if (_stop) {
+				return;
+			}
+			_pool._evaluate_share(alg, _index, _pool.num_workers());
+			_pool._done.up();
+		}
+	}
+
+	bool Admission_pool::admissible(Sched_alg &alg, Test test, Rq_task::Rq_task task,
+	                                Rq_view const &view, Rq_util util)
+	{
+		switch (test) {
+		case Test::fp:
+			return alg.fp_admission_test(&task, &view, &util, util.rate_monotonic && alg.rate_monotonic(&task, &view));
+		case Test::edf:
+			return alg.edf_test(&task, &view, &util);
+		case Test::amc:
+			return alg.amc_rtb(&task, &view);
+		case Test::none:
+			break;
+		}
+		return true;
+	}
+
+	void Admission_pool::_evaluate(Sched_alg &alg, Verdict *verdict)
+	{
+		verdict->headroom = 0;
+		if (verdict->core < 0 || verdict->core >= (int)_snapshots.size()) {
+			verdict->admissible = false;
+			return;
+		}
+		Snapshot const &s = _snapshots[verdict->core];
+
+		alg.core(verdict->core);
+		verdict->admissible = admissible(alg, _test, *_task, s.view, s.util);
+	}
+
+	void Admission_pool::_evaluate_share(Sched_alg &alg, int index, int stride)
+	{
+		for (int i = index; i < (int)_verdicts->size(); i += stride) {
+			_evaluate(alg, &(*_verdicts)[i]);
+		}
+	}
+
+	void Admission_pool::snapshot(int core, Rq_view const *view, Rq_util const *util)
+	{
+		if (core < 0 || core >= (int)_snapshots.size()) {
+			return;
+		}
+		_snapshots[core].view = *view;
+		_snapshots[core].util = *util;
+	}
+
+	void Admission_pool::evaluate(Rq_task::Rq_task const &task, Test test, std::vector<Verdict> *verdicts)
+	{
+		/* a core without a snapshot is not admissible, see _evaluate */
+		for (auto &verdict : *verdicts) {
+			if (verdict.core < 0 || verdict.core >= (int)_snapshots.size()) {
+				SCHED_WRN("Admission_pool: core %d has no snapshot", verdict.core);
+			}
+		}
+
+		_task = &task;
+		_test = test;
+		_verdicts = verdicts;
+
+		int num = _workers.size();
+		if (num == 0 || verdicts->size() < 2) {
+			_evaluate_share(_alg, 0, 1);
+			return;
+		}
+
+		int busy = (int)verdicts->size() < num ? verdicts->size() : num;
+		for (int i = 0; i < busy; i++) {
+			_workers[i]->go.up();
+		}
+		for (int i = 0; i < busy; i++) {
+			_done.down();
+		}
+	}
+
+	Admission_pool::Admission_pool(int num_cores, int num_workers)
+	: _snapshots(num_cores)
+	{
+		for (auto &s : _snapshots) {
+			Sched_alg::reset_util(&s.util);
+		}
+
+		for (int i = 0; i < num_workers; i++) {
+			Worker *worker = new Worker(*this, i);
+			Genode::env()->cpu_session()->affinity(worker->cap(), Genode::Affinity::Location(i % num_cores, 0));
+			worker->start();
+			_workers.push_back(worker);
+		}
+	}
+
+	Admission_pool::~Admission_pool()
+	{
+		for (Worker *worker : _workers) {
+			worker->stop();
+			worker->join();
+			delete worker;
+		}
+	}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * \brief  Completion of provisional admissions
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include "sched_controller/background_admission.h"
+
+namespace Sched_controller
+{
+
+	void Background_admission::entry()
+	{
+		std::list<Job> job;
+		while (true) {
+			_queued.down();
+			{
+				Genode::Lock::Guard guard(_lock);
+				job.splice(job.end(), _todo, _todo.begin());
+			}
+
+			Job &j = job.front();
+			j.admissible = Admission_pool::admissible(_alg, j.test, j.task, j.view, j.util);
+
+			Genode::Lock::Guard guard(_lock);
+			_done.splice(_done.end(), job);
+		}
+	}
+
+	void Background_admission::submit(Job const &job)
+	{
+		{
+			Genode::Lock::Guard guard(_lock);
+			_todo.push_back(job);
+		}
+		_queued.up();
+	}
+
+	void Background_admission::take_done(std::list<Job> *done)
+	{
+		Genode::Lock::Guard guard(_lock);
+		done->splice(done->end(), _done);
+	}
+
+	Background_admission::Background_admission()
+	: Genode::Thread<32*1024>("background_admission")
+	{
+		_alg.record(false);
+	}
+
+}
@@ -16,6 +16,7 @@
 /* local includes */
 #include <sched_controller_session/sched_controller_session.h>
 #include <sched_controller/sched_controller.h>
+#include <sched_controller/opt_timeout.h>
 #include "rq_task/rq_task.h"
 
 namespace Sched_controller {
@@ -33,11 +34,30 @@ namespace Sched_controller {
 				PINF("sched_controller is initialized");
 			}
 
+			/* a negative core lets the Task_allocator choose the run queue */
 			int new_task(Rq_task::Rq_task task, int core)
 			{
+				if (core < 0)
+					return _ctr->allocate_task(task);
 				return _ctr->enq(core, task);
 			}
 
+			Admission_result admit(Rq_task::Rq_task task, int core, Admission_budget budget)
+			{
+				return _ctr->admit(core, task, budget);
+			}
+
+			Admission_result admission_result(Genode::String<32> task_name)
+			{
+				return _ctr->admission_result(task_name.string());
+			}
+
+			/* the task has departed, its capacity is reclaimed at once */
+			int remove_task(Genode::String<32> task_name)
+			{
+				return _ctr->remove_task(task_name.string());
+			}
+
 			void set_sync_ds(Genode::Dataspace_capability ds_cap)
 			{
 				_ctr->set_sync_ds(ds_cap);
@@ -59,6 +79,12 @@ namespace Sched_controller {
 				_ctr->get_optimizer()->start_optimizing(task_name.string());
 			}
 
+			/* called by the Opt_timeout when the earliest check point has passed */
+			void check_due()
+			{
+				_ctr->get_optimizer()->check_due();
+			}
+
 			void set_opt_goal (Genode::Ram_dataspace_capability xml_ds_cap)
 			{
 				_ctr->get_optimizer()->set_goal(xml_ds_cap);
@@ -72,6 +98,45 @@ namespace Sched_controller {
 			{
 				_ctr->get_optimizer()->last_job_started(task_name.string());
 			}
+
+			// Sensitivity analysis
+			unsigned long long headroom(int core, unsigned long long period)
+			{
+				return _ctr->get_headroom(core, period);
+			}
+
+			long long wcet_slack(Genode::String<32> task_name)
+			{
+				return _ctr->get_wcet_slack(task_name.string());
+			}
+
+			// Recording of the optimizer inputs
+			Genode::Dataspace_capability opt_trace()
+			{
+				return _ctr->get_opt_trace();
+			}
+
+			void dump_opt_trace()
+			{
+				_ctr->dump_opt_trace();
+			}
+
+			// Event trace
+			Genode::Dataspace_capability trace()
+			{
+				return _ctr->get_trace();
+			}
+
+			// Statistics
+			Genode::Dataspace_capability stats()
+			{
+				return _ctr->get_stats_ds();
+			}
+
+			Sched_stats::Core_stats get_stats(int core)
+			{
+				return _ctr->get_stats(core);
+			}
 			
 			
 			/* Session_component constructor enhanced by Sched_controller object */
@@ -132,6 +197,12 @@ int main(void)
 	static Sched_controller::Root_component sched_controller_root(&ep, &sliced_heap, &ctr);
 	env()->parent()->announce(ep.manage(&sched_controller_root));
 
+	/* the check points of the optimizer are processed in the entrypoint, via a session of its own */
+	static Sched_controller::Session_component opt_session(&ctr);
+	static Sched_controller::Opt_timeout opt_timeout(ep.manage(&opt_session));
+	ctr.get_optimizer()->on_timeout(&opt_timeout);
+	opt_timeout.start();
+
 	sleep_forever();
 
 	return 0;
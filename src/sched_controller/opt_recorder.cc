@@ -0,0 +1,179 @@
+/*
+ * \brief  Recorder of the optimizer inputs
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <cstring>
+
+#include "sched_controller/opt_recorder.h"
+
+namespace Sched_controller
+{
+
+	bool Opt_recorder::_append(Opt_trace::Type type, const void *a, Genode::size_t a_len,
+	                           const void *b, Genode::size_t b_len)
+	{
+		Genode::size_t len = a_len + b_len;
+		if (_header->used + sizeof(Opt_trace::Record) + Opt_trace::padded(len) > _capacity)
+		{
+			_header->dropped++;
+			return false;
+		}
+
+		char *pos = _data + _header->used;
+		Opt_trace::Record record { (Genode::uint32_t)type, (Genode::uint32_t)len };
+		std::memcpy(pos, &record, sizeof(record));
+		pos += sizeof(record);
+		if (a_len)
+			std::memcpy(pos, a, a_len);
+		if (b_len)
+			std::memcpy(pos + a_len, b, b_len);
+		std::memset(pos + len, 0, Opt_trace::padded(len) - len);
+
+		_header->used += sizeof(Opt_trace::Record) + Opt_trace::padded(len);
+		return true;
+	}
+
+	void Opt_recorder::goal(const char *xml)
+	{
+		_append(Opt_trace::GOAL, xml, std::strlen(xml) + 1);
+	}
+
+	void Opt_recorder::add_task(unsigned int core, Rq_task::Rq_task const &task)
+	{
+		Opt_trace::Task t;
+		std::memset(&t, 0, sizeof(t));
+		t.core          = core;
+		t.task_id       = task.task_id;
+		t.task_class    = (Genode::int32_t)task.task_class;
+		t.task_strategy = (Genode::int32_t)task.task_strategy;
+		t.prio          = task.prio;
+		t.deadline      = task.deadline;
+		t.wcet          = task.wcet;
+		t.wcet_hi       = task.wcet_hi;
+		t.inter_arrival = task.inter_arrival;
+		t.jitter        = task.jitter;
+		t.blocking      = task.blocking;
+		std::memcpy(t.name, task.name, sizeof(t.name) - 1);
+		_append(Opt_trace::ADD_TASK, &t, sizeof(t));
+	}
+
+	void Opt_recorder::call(Opt_trace::Type type, std::string const &task_name)
+	{
+		_append(type, task_name.c_str(), task_name.size() + 1);
+	}
+
+	void Opt_recorder::scheduling_allowed(std::string const &task_name, int result)
+	{
+		Genode::int32_t r = result;
+		_append(Opt_trace::SCHEDULING_ALLOWED, &r, sizeof(r), task_name.c_str(), task_name.size() + 1);
+	}
+
+	void Opt_recorder::time(unsigned long long ms)
+	{
+		Genode::uint64_t t = ms;
+		_append(Opt_trace::TIME, &t, sizeof(t));
+	}
+
+	void Opt_recorder::monitor(Mon_manager::Monitoring_object const *threads, int max_threads)
+	{
+		/* the snapshot ends at the first unused object */
+		int num_threads = 0;
+		while (num_threads < max_threads && threads[num_threads].foc_id != 0)
+			num_threads++;
+
+		Genode::size_t len = num_threads * sizeof(Opt_trace::Thread);
+		if (_header->used + sizeof(Opt_trace::Record) + len > _capacity)
+		{
+			_header->dropped++;
+			return;
+		}
+
+		/* convert in place behind the record header */
+		Opt_trace::Record record { Opt_trace::MONITOR, (Genode::uint32_t)len };
+		char *pos = _data + _header->used;
+		std::memcpy(pos, &record, sizeof(record));
+
+		Opt_trace::Thread *out = (Opt_trace::Thread *)(pos + sizeof(record));
+		for (int i = 0; i < num_threads; i++)
+		{
+			Opt_trace::Thread t;
+			std::memset(&t, 0, sizeof(t));
+			t.foc_id         = threads[i].foc_id;
+			t.prio           = threads[i].prio;
+			t.core           = threads[i].affinity.xpos();
+			t.execution_time = threads[i].execution_time.value;
+			t.arrival_time   = threads[i].arrival_time;
+			t.start_time     = threads[i].start_time;
+			t.exit_time      = threads[i].exit_time;
+			std::strncpy(t.name, threads[i].thread_name.string(), sizeof(t.name) - 1);
+			std::memcpy(out + i, &t, sizeof(t));
+		}
+		_header->used += sizeof(record) + len;
+	}
+
+	void Opt_recorder::rip(long long unsigned const *rip)
+	{
+		/* rip[0] is written by the monitor, a larger count would read beyond the dataspace */
+		Genode::uint64_t num = rip[0];
+		if (num > (Opt_trace::RIP_SIZE - 1) / 2)
+		{
+			num = (Opt_trace::RIP_SIZE - 1) / 2;
+		}
+		_append(Opt_trace::RIP, &num, sizeof(num), rip + 1, num * 2 * sizeof(Genode::uint64_t));
+	}
+
+	void Opt_recorder::digest(unsigned long long digest)
+	{
+		Genode::uint64_t d = digest;
+		_append(Opt_trace::DIGEST, &d, sizeof(d));
+	}
+
+	void Opt_recorder::dump()
+	{
+		enum { BYTES_PER_LINE = 32 };
+		static const char hex[] = "0123456789abcdef";
+
+		const unsigned char *p = (const unsigned char *)_header;
+		Genode::size_t size = sizeof(Opt_trace::Header) + _header->used;
+		PINF("opt_trace begin: %lu bytes, %u records dropped", (unsigned long)size, _header->dropped);
+
+		char line[2 * BYTES_PER_LINE + 1];
+		for (Genode::size_t offset = 0; offset < size; offset += BYTES_PER_LINE)
+		{
+			Genode::size_t n = 0;
+			for (; n < BYTES_PER_LINE && offset + n < size; n++)
+			{
+				line[2 * n]     = hex[p[offset + n] >> 4];
+				line[2 * n + 1] = hex[p[offset + n] & 0xf];
+			}
+			line[2 * n] = 0;
+			PINF("opt_trace: %s", line);
+		}
+		PINF("opt_trace end");
+	}
+
+	Opt_recorder::Opt_recorder(Genode::size_t size, int num_cores)
+	{
+		_ds_cap = Genode::env()->ram_session()->alloc(size);
+		_header = Genode::env()->rm_session()->attach(_ds_cap);
+		_data = (char *)(_header + 1);
+		_capacity = size - sizeof(Opt_trace::Header);
+
+		_header->magic = Opt_trace::MAGIC;
+		_header->version = Opt_trace::VERSION;
+		_header->num_cores = num_cores;
+		_header->used = 0;
+		_header->dropped = 0;
+	}
+
+	Opt_recorder::~Opt_recorder()
+	{
+		Genode::env()->rm_session()->detach(_header);
+		Genode::env()->ram_session()->free(_ds_cap);
+	}
+
+}
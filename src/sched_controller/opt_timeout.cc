@@ -0,0 +1,61 @@
+/*
+ * \brief  Single timeout for the check points of the optimizer
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include "sched_controller/log.h"
+#include "sched_controller/opt_timeout.h"
+
+namespace Sched_controller
+{
+
+	void Opt_timeout::entry()
+	{
+		_timer.sigh(_receiver.manage(&_expired));
+
+		while (true) {
+			_receiver.wait_for_signal();
+
+			unsigned long long now = _timer.elapsed_ms();
+			{
+				Genode::Lock::Guard guard(_lock);
+				if (_fresh) {
+					_due = (_delay == ~0ULL) ? ~0ULL : now + _delay;
+					_fresh = false;
+				}
+			}
+			if (_due == ~0ULL) {
+				continue;
+			}
+
+			if (_due > now) {
+				/* replaces a timeout that is still pending */
+				_timer.trigger_once((_due - now) * 1000);
+				continue;
+			}
+
+			/* the optimizer programs the next check point during the call */
+			SCHED_DBG("Opt_timeout: check points due at %llu ms", _due);
+			_due = ~0ULL;
+			_session.check_due();
+		}
+	}
+
+	void Opt_timeout::program(unsigned long long delay_ms)
+	{
+		{
+			Genode::Lock::Guard guard(_lock);
+			_delay = delay_ms;
+			_fresh = true;
+		}
+		Genode::Signal_transmitter(_programmed_cap).submit();
+	}
+
+	Opt_timeout::Opt_timeout(Genode::Capability<Session> session)
+	: Genode::Thread<8*1024>("opt_timeout"),
+	  _programmed_cap(_receiver.manage(&_programmed)),
+	  _session(session)
+	{ }
+
+}
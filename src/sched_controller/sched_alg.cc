@@ -4,53 +4,82 @@
  * \date   2016/09/22
  */
 
-#include <base/printf.h>
+#include "sched_controller/log.h"
+#include "sched_controller/stats.h"
+#include "sched_controller/trace.h"
 #include "rq_task/rq_task.h"
 #include "sched_controller/sched_alg.h"
+#include "sched_controller/interference.h"
 #include <math.h>
+#include <algorithm>
 
 namespace Sched_controller
 {
-	bool Sched_alg::_compute_repsonse_time(Rq_task::Rq_task *new_task, int num_elements, Rq_task::Rq_task *check_task)
+	unsigned long long Sched_alg::_interference(unsigned long long const *wcet, unsigned long long const *period,
+	                                            unsigned long long const *jitter, int num_tasks, unsigned long long w)
 	{
-		Rq_task::Rq_task *_curr_task;
-		_response_time_old = check_task->wcet;
+		/* vectorized if the target supports it, see interference.h */
+		return Interference::simd(wcet, period, jitter, num_tasks, w);
+	}
+
+
+
+	bool Sched_alg::_compute_repsonse_time(Rq_task::Rq_task *new_task, Rq_view const *view, int num_hp, int check)
+	{
+		unsigned long long base, jitter, deadline;
+		int task_id;
+		if (check < 0)
+		{
+			base = new_task->wcet + new_task->blocking;
+			jitter = new_task->jitter;
+			deadline = new_task->deadline;
+			task_id = new_task->task_id;
+		}
+		else
+		{
+			base = view->wcet[check] + view->blocking[check];
+			jitter = view->jitter[check];
+			deadline = view->deadline[check];
+			task_id = view->task_id[check];
+		}
+
+		/*
+		 * _response_time is the busy window w of check_task, its response time is w + J.
+		 * Higher priority tasks released with jitter J can hit the window ceil((w + J)/T) times.
+		 */
+		_response_time_old = base;
 		while (true)
 		{
-			_curr_task = _first_task;
-			_response_time = check_task->wcet;
-			for (int i=0; i<num_elements; ++i)
+			if (!_spend(_response_time_old + jitter))
 			{
-				_response_time += ceil((double)_response_time_old / (double)_curr_task->inter_arrival) * _curr_task->wcet;
-				_curr_task++;
+				return false;
 			}
+			_response_time = base + _interference(view->wcet.data(), view->period.data(), view->jitter.data(), num_hp, _response_time_old);
 			
 			//If check_task is another task then new task we have to add the new task here
-			if (new_task != check_task)
+			if (check >= 0)
 			{
-				_response_time += ceil((double)_response_time_old / (double)new_task->inter_arrival) * new_task->wcet;
+				_response_time += ceil((double)(_response_time_old + new_task->jitter) / (double)new_task->inter_arrival) * new_task->wcet;
 			}
 
-			PINF("response_time = %llu, response_time_old = %llu, deadline = %llu", _response_time, _response_time_old, check_task->deadline);
+			SCHED_HOT("response_time = %llu, response_time_old = %llu, deadline = %llu", _response_time + jitter, _response_time_old, deadline);
+			if (_record)
+				SCHED_TRACE(RTA_ITERATION, Sched_trace::ANY_CORE, task_id, nullptr, _response_time + jitter, deadline);
 			
 			/*Since the response_time is increasing with each iteration, it has to be always
 			 * smaller then the deadline --> we can stop if we hit the deadline
 			 */
-			if (_response_time > check_task->deadline)
+			if (_response_time + jitter > deadline)
 			{
 				//Task-Set is NOT schedulable
-				PWRN("Task-Set is NOT schedulable!");
+				SCHED_HOT("Task %llu is NOT schedulable, response time = %llu", (long long)task_id, _response_time + jitter);
 				return false;
 			}
 			if (_response_time_old >= _response_time)
 			{
-				if (_response_time <= check_task->deadline)
-				{
-					//Task-Set is schedulable
-					PINF("Task-Set is schedulable! Response time = %llu, deadline = %llu", _response_time, check_task->deadline);
-					return true;
-
-				}
+				//Task-Set is schedulable
+				SCHED_HOT("Task-Set is schedulable! Response time = %llu, deadline = %llu", _response_time + jitter, deadline);
+				return true;
 			}
 			_response_time_old = _response_time;
 		} // while(true)
@@ -58,13 +87,93 @@ namespace Sched_controller
 
 
 
-	bool Sched_alg::RTA(Rq_task::Rq_task *new_task, Rq_buffer<Rq_task::Rq_task> *rq_buf)
+	bool Sched_alg::_response_time_ok(Rq_view const *tasks, int check, Rq_view const *hp, int num_hp)
+	{
+		unsigned long long base = tasks->wcet[check] + tasks->blocking[check];
+		_response_time_old = base;
+		while (true)
+		{
+			if (!_spend(_response_time_old + tasks->jitter[check]))
+			{
+				return false;
+			}
+			_response_time = base + _interference(hp->wcet.data(), hp->period.data(), hp->jitter.data(), num_hp, _response_time_old);
+
+			if (_response_time + tasks->jitter[check] > tasks->deadline[check])
+			{
+				return false;
+			}
+			if (_response_time_old >= _response_time)
+			{
+				return true;
+			}
+			_response_time_old = _response_time;
+		}
+	}
+
+
+
+	bool Sched_alg::_amc_response_time_ok(Rq_view const *tasks, int check, Rq_view const *hp, int num_hp)
+	{
+		/* lo mode: every task runs with its lo budget */
+		if (!_response_time_ok(tasks, check, hp, num_hp))
+		{
+			return false;
+		}
+		unsigned long long response_time_lo = _response_time;
+
+		if (!tasks->hi[check])
+		{
+			return true;
+		}
+
+		/*
+		 * hi mode: hi tasks run with their hi budget, lo tasks can
+		 * only interfere until the mode switch, i.e. within the
+		 * lo busy window
+		 */
+		double lo_interference = 0.0;
+		for (int j=0; j<num_hp; ++j)
+		{
+			lo_interference += !hp->hi[j] * ceil((double)(response_time_lo + hp->jitter[j]) / (double)hp->period[j]) * (double)hp->wcet[j];
+		}
+
+		unsigned long long base = tasks->wcet_hi[check] + tasks->blocking[check] + (unsigned long long)lo_interference;
+		_response_time_old = base;
+		while (true)
+		{
+			if (!_spend(_response_time_old + tasks->jitter[check]))
+			{
+				return false;
+			}
+			double hi_interference = 0.0;
+			for (int j=0; j<num_hp; ++j)
+			{
+				hi_interference += hp->hi[j] * ceil((double)(_response_time_old + hp->jitter[j]) / (double)hp->period[j]) * (double)hp->wcet_hi[j];
+			}
+			_response_time = base + (unsigned long long)hi_interference;
+
+			if (_response_time + tasks->jitter[check] > tasks->deadline[check])
+			{
+				SCHED_INF("AMC: task %s misses its deadline after a mode switch, R_hi = %llu", tasks->name[check].str, _response_time + tasks->jitter[check]);
+				return false;
+			}
+			if (_response_time_old >= _response_time)
+			{
+				return true;
+			}
+			_response_time_old = _response_time;
+		}
+	}
+
+
+
+	bool Sched_alg::RTA(Rq_task::Rq_task *new_task, Rq_view const *view)
 	{
-		Rq_task::Rq_task *_curr_task;
-		int num_elements = rq_buf->get_num_elements();
+		int num_elements = view->size();
 		/*
 		 * Assuming that each task for schedulable if it is alone,
-		 * the task is acceptet if the rq_buffer is empty
+		 * the task is acceptet if the run queue is empty
 		 */
 		if (num_elements == 0)
 		{
@@ -75,127 +184,699 @@ namespace Sched_controller
 		 * RTA-Algorithm
 		 * We assume that the existing Task-Set is schedulable without
 		 * the new task. Therefore the response time has to be computed
-		 * for the new task and all tasks having a smaller priority then
-		 * the new task and for the new task. The tasks in the rq_buffer
-		 * are assumed to be sorted by priorities.
+		 * for the new task and all tasks having a smaller or the same
+		 * priority. Tasks of equal priority interfere with each other.
 		 */
+		int position = view->position(new_task->prio);
+		SCHED_HOT("New task is inserted at position %lld of %lld", (long long)position, (long long)num_elements);
+		if (!_compute_repsonse_time(new_task, view, position, -1))
+		{
+			//Task Set not schedulable
+			SCHED_INF("Task set is not schedulable!");
+			return false;
+		}
 
-		_first_task = rq_buf->get_first_element();
-		_curr_task = _first_task;
-		if (new_task->prio < (rq_buf->get_last_element())->prio)
+		/* the tasks of equal priority come right before position */
+		int first_affected = position;
+		while (first_affected > 0 && view->prio[first_affected - 1] == new_task->prio)
 		{
-			PINF("New task has lower prio then all other tasks, prio_new = %d, prio_last = %d", new_task->prio, rq_buf->get_last_element()->prio);
-			_response_time_old = new_task->wcet;
-			if (!_compute_repsonse_time(new_task, num_elements, new_task))
+			--first_affected;
+		}
+		for (int i=first_affected; i<num_elements; ++i)
+		{
+			//check existing tasks with prio lower then or equal to new_task
+			if (!_compute_repsonse_time(new_task, view, i, i))
 			{
 				//Task Set not schedulable
-				PWRN("Task set is not schedulable!");
+				SCHED_INF("Task set is not schedulable!");
 				return false;
 			}
-
-		}
-		else
-		{
-			/*
-			 * Compute response time for all tasks having priority smaller
-			 * then the new task
-			 */
-			PINF("New task has higher or the same prio then lowest existing task, prio_new = %d, prio_last = %d", new_task->prio, rq_buf->get_last_element()->prio);
-			for (int i=0; i<num_elements; ++i)
-			{				
-				_response_time_old = _curr_task->wcet;
-				if(_curr_task->prio <= new_task->prio)
-				{
-					//check existing tasks with prio lower then new_task
-					if (!_compute_repsonse_time(new_task, i, _curr_task))
-					{
-						//Task Set not schedulable
-						PWRN("Task set is not schedulable!");
-						return false;
-					}
-				}
-				
-				//check new_task at right possition
-				if (_curr_task->prio > new_task->prio && (_curr_task+1)->prio <= new_task->prio && i > 0)
-				{
-					if (!_compute_repsonse_time(new_task, i+1, new_task))
-					{
-						//Task Set not schedulable
-						PINF("Task set is not schedulable!");
-						return false;
-					}
-				}
-				++_curr_task;
-			}
 		}
-		PINF("All Task-Sets passed the RTA Algorithm -> Task-Set schedulable!");
+		SCHED_INF("All Task-Sets passed the RTA Algorithm -> Task-Set schedulable!");
 		return true;
 
 	}//RTA
 
 
-	bool Sched_alg::fp_sufficient_test(Rq_task::Rq_task *new_task, Rq_buffer<Rq_task::Rq_task> *rq_buf)
+	bool Sched_alg::fp_sufficient_test(Rq_task::Rq_task *new_task, Rq_view const *view)
 	{
-		Rq_task::Rq_task *_curr_task;
-		int num_elements = rq_buf->get_num_elements();
+		int num_elements = view->size();
 		if (num_elements == 0)
 		{
 			//Rq is empty --> Task set is schedulable
-			PINF("Rq is empty, Task set is schedulable!");
+			SCHED_HOT("Rq is empty, Task set is schedulable!");
 			return true;
 		}
 
+		/*
+		 * Upper bound of Bini et al., extended by blocking B and jitter J:
+		 * R_ub = (C + B + sum_hp(C_j(1 - U_j) + U_j J_j)) / (1 - sum_hp(U_j)) + J
+		 * Only the new task and the tasks of lower or equal priority are
+		 * affected by the admission, tasks of equal priority interfere
+		 * with each other.
+		 */
 		double R_ub, sum_util = 0.0, sum_util_wcet = 0.0;
-		_curr_task = rq_buf->get_first_element();
+		double util_new = (double)new_task->wcet / (double)new_task->inter_arrival;
+		double util_wcet_new = new_task->wcet * (1 - util_new) + new_task->jitter * util_new;
+		int position = view->position(new_task->prio);
 
-		for (int i=0; i<num_elements; ++i)
+		for (int i=0; i<=num_elements; ++i)
 		{
-			//add new_task if prio bigger then curr_task
-			if (new_task->prio >= _curr_task->prio)
+			if (i == position)
 			{
-				R_ub = ((double)new_task->wcet + (double)sum_util_wcet) / (1 - sum_util);
-				PINF("R_ub: %d.%d at new_task possition %d, deadline: %llu ", (int)R_ub, (int)(R_ub*100 - (int)R_ub * 100), i, new_task->deadline);
+				if (sum_util >= 1)
+				{
+					SCHED_INF("Utilization of higher priority tasks is %d%%, upper bound not applicable.", (int)(sum_util*100));
+					return false;
+				}
+				R_ub = ((double)new_task->wcet + (double)new_task->blocking + sum_util_wcet) / (1 - sum_util) + (double)new_task->jitter;
+				SCHED_HOT("R_ub*100: %llu at new_task possition %lld, deadline: %llu", (unsigned long long)(R_ub*100), (long long)i, new_task->deadline);
 				if (R_ub > new_task->deadline)
 				{
 					//Deadline hit for new task
-					PWRN("Deadline hit for task %d, Task set might be not schedulable! Maybe try an exact test.", new_task->task_id);
+					SCHED_INF("Deadline hit for task %d, Task set might be not schedulable! Maybe try an exact test.", new_task->task_id);
 					return false;
 				}
-				sum_util += (double)new_task->wcet / (double)new_task->inter_arrival;
-				sum_util_wcet += new_task->wcet * (1 - ((double)new_task->wcet / (double)new_task->inter_arrival));
-				
-				//PINF("sum_util: %d.%d", (int)sum_util, (int)(sum_util*100 - (int)sum_util * 100));
-				//PINF("sum_util_wcet: %d.%d", (int)sum_util_wcet, (int)(sum_util_wcet*100 - (int)sum_util_wcet * 100));
-			}			
-			R_ub = ((double)_curr_task->wcet + (double)sum_util_wcet) / (1 - sum_util);
-			PINF("R_ub: %d.%d at possition %d, deadline: %llu", (int)R_ub, (int)(R_ub*100 - (int)R_ub * 100), i, _curr_task->deadline);
+			}
+			if (i == num_elements)
+			{
+				break;
+			}
 
-			if (R_ub > _curr_task->deadline)
+			double util = (double)view->wcet[i] / (double)view->period[i];
+			if (view->prio[i] <= new_task->prio)
 			{
-				//Deadline hit for task i
-				PWRN("Deadline hit for task %d, Task set might be not schedulable! Maybe try an exact test.", _curr_task->task_id);
-				return false;
+				double u = sum_util + util_new;
+				if (u >= 1)
+				{
+					SCHED_INF("Utilization of higher priority tasks is %d%%, upper bound not applicable.", (int)(u*100));
+					return false;
+				}
+				R_ub = ((double)view->wcet[i] + (double)view->blocking[i] + sum_util_wcet + util_wcet_new) / (1 - u) + (double)view->jitter[i];
+				SCHED_HOT("R_ub*100: %llu at possition %lld, deadline: %llu", (unsigned long long)(R_ub*100), (long long)i, view->deadline[i]);
+
+				if (R_ub > view->deadline[i])
+				{
+					//Deadline hit for task i
+					SCHED_INF("Deadline hit for task %d, Task set might be not schedulable! Maybe try an exact test.", view->task_id[i]);
+					return false;
+				}
 			}
-			sum_util += (double)_curr_task->wcet / (double)_curr_task->inter_arrival;
-			sum_util_wcet += _curr_task->wcet * (1 - ((double)_curr_task->wcet / (double)_curr_task->inter_arrival));
+			sum_util += util;
+			sum_util_wcet += view->wcet[i] * (1 - util) + view->jitter[i] * util;
 			
 			//PINF("sum_util: %d.%d", (int)sum_util, (int)(sum_util*100 - (int)sum_util * 100));
 			//PINF("sum_util_wcet: %d.%d", (int)sum_util_wcet, (int)(sum_util_wcet*100 - (int)sum_util_wcet * 100));
-			++_curr_task;
 		}
-		
-		//add new_task if not done before
-		if (new_task->prio < (--_curr_task)->prio)
-		{			
-			R_ub = ((double)new_task->wcet + (double)sum_util_wcet) / (1 - sum_util);			
-			PINF("R_ub = %d.%d at end, deadline = %llu", (int)R_ub, (int)(R_ub*100 - (int)R_ub * 100), new_task->deadline);
-			if (R_ub > (double)new_task->deadline)
+		SCHED_HOT("Upper bound lower then deadline --> task-set is schedulable!");
+		return true;
+	}
+
+
+	bool Sched_alg::liu_layland_test(Rq_task::Rq_task *new_task, Rq_util *util)
+	{
+		int n = util->num_tasks + 1;
+		double u = util->utilization + (double)new_task->wcet / (double)new_task->inter_arrival;
+
+		/* n(2^(1/n) - 1) */
+		if (u <= n * (pow(2.0, 1.0 / n) - 1))
+		{
+			SCHED_HOT("Liu and Layland bound holds, utilization = %llu%%", (unsigned long long)(u*100));
+			return true;
+		}
+		return false;
+	}
+
+
+	bool Sched_alg::hyperbolic_test(Rq_task::Rq_task *new_task, Rq_util *util)
+	{
+		double h = util->hyperbolic * ((double)new_task->wcet / (double)new_task->inter_arrival + 1);
+
+		/* prod(U_i + 1) <= 2 */
+		if (h <= 2.0)
+		{
+			SCHED_HOT("Hyperbolic bound holds");
+			return true;
+		}
+		return false;
+	}
+
+
+	bool Sched_alg::rate_monotonic(Rq_task::Rq_task *new_task, Rq_view const *view)
+	{
+		/* the utilization bounds do not cover jitter and blocking */
+		if (new_task->inter_arrival == 0 || new_task->deadline < new_task->inter_arrival
+		    || new_task->jitter > 0 || new_task->blocking > 0)
+		{
+			return false;
+		}
+
+		/*
+		 * A task with a higher priority must not have a longer period
+		 * and vice versa. Equal priorities are only fine for equal periods.
+		 */
+		int num_elements = view->size();
+		for (int i=0; i<num_elements; ++i)
+		{
+			if (view->prio[i] > new_task->prio && view->period[i] > new_task->inter_arrival)
+				return false;
+			if (view->prio[i] < new_task->prio && view->period[i] < new_task->inter_arrival)
+				return false;
+			if (view->prio[i] == new_task->prio && view->period[i] != new_task->inter_arrival)
+				return false;
+		}
+		return true;
+	}
+
+
+	bool Sched_alg::fp_admission_test(Rq_task::Rq_task *new_task, Rq_view const *view, Rq_util *util, bool rate_monotonic)
+	{
+		if (new_task->inter_arrival == 0 || new_task->wcet + new_task->blocking + new_task->jitter > new_task->deadline)
+		{
+			SCHED_WRN("Task %s can never meet its deadline", new_task->name);
+			return false;
+		}
+
+		/* necessary condition, no test can accept an overloaded core */
+		if (util->utilization + (double)new_task->wcet / (double)new_task->inter_arrival > 1.0)
+		{
+			SCHED_INF("Utilization would exceed 100%%, Task-Set is NOT schedulable!");
+			return false;
+		}
+
+		if (rate_monotonic)
+		{
+			if (liu_layland_test(new_task, util))
+			{
+				if (_record)
+				{
+					SCHED_TRACE(SUFFICIENT_TEST, Sched_trace::ANY_CORE, new_task->task_id, new_task->name, 1, 0);
+					SCHED_STAT_INC(_core, sufficient);
+				}
+				return true;
+			}
+			if (hyperbolic_test(new_task, util))
+			{
+				if (_record)
+				{
+					SCHED_TRACE(SUFFICIENT_TEST, Sched_trace::ANY_CORE, new_task->task_id, new_task->name, 2, 0);
+					SCHED_STAT_INC(_core, sufficient);
+				}
+				return true;
+			}
+		}
+
+		if (fp_sufficient_test(new_task, view))
+		{
+			if (_record)
+			{
+				SCHED_TRACE(SUFFICIENT_TEST, Sched_trace::ANY_CORE, new_task->task_id, new_task->name, 3, 0);
+				SCHED_STAT_INC(_core, sufficient);
+			}
+			return true;
+		}
+		if (!_record)
+		{
+			return RTA(new_task, view);
+		}
+		SCHED_TRACE(SUFFICIENT_TEST, Sched_trace::ANY_CORE, new_task->task_id, new_task->name, 0, 0);
+
+		//If sufficient tests fail --> execute RTA (exact test)
+		SCHED_STAT_INC(_core, rta);
+		Genode::Trace::Timestamp rta_start = Genode::Trace::timestamp();
+		bool schedulable = RTA(new_task, view);
+		SCHED_STAT_LATENCY(_core, rta_hist, Genode::Trace::timestamp() - rta_start);
+		return schedulable;
+	}
+
+
+	void Sched_alg::add_util(Rq_util *util, Rq_task::Rq_task *new_task, bool rate_monotonic)
+	{
+		double u = (new_task->inter_arrival > 0) ? (double)new_task->wcet / (double)new_task->inter_arrival : 1.0;
+		util->utilization += u;
+		util->hyperbolic *= u + 1;
+		util->num_tasks++;
+		util->rate_monotonic = rate_monotonic;
+	}
+
+
+	void Sched_alg::remove_util(Rq_util *util, Rq_task::Rq_task const *task)
+	{
+		/* an empty run queue starts over, without the rounding errors */
+		if (util->num_tasks <= 1) {
+			reset_util(util);
+			return;
+		}
+		double u = (task->inter_arrival > 0) ? (double)task->wcet / (double)task->inter_arrival : 1.0;
+		util->utilization = std::max(util->utilization - u, 0.0);
+		util->hyperbolic = std::max(util->hyperbolic / (u + 1), 1.0);
+		util->num_tasks--;
+	}
+
+
+	void Sched_alg::reset_util(Rq_util *util)
+	{
+		util->utilization = 0.0;
+		util->hyperbolic = 1.0;
+		util->num_tasks = 0;
+		util->rate_monotonic = true;
+	}
+
+
+	bool Sched_alg::audsley(Rq_task::Rq_task *new_task, std::vector<Rq_task::Rq_task> const *rq_tasks, std::vector<Rq_task::Rq_task> *order)
+	{
+		int num_elements = rq_tasks->size();
+		std::vector<Rq_task::Rq_task const*> tasks;
+		std::vector<int> unassigned;
+		std::vector<int> lowest_first;
+		tasks.reserve(num_elements + 1);
+		unassigned.reserve(num_elements + 1);
+		lowest_first.reserve(num_elements + 1);
+
+		int top_prio = new_task->prio;
+		tasks.push_back(new_task);
+		for (int i=0; i<num_elements; ++i)
+		{
+			Rq_task::Rq_task const *task = &(*rq_tasks)[i];
+			top_prio = std::max(top_prio, task->prio);
+			tasks.push_back(task);
+		}
+		top_prio = std::max(top_prio, num_elements);
+
+		/* _all[k] mirrors tasks[k] */
+		_all.clear();
+		_all.reserve(tasks.size());
+		for (auto task : tasks)
+		{
+			_all.push_back(*task);
+			unassigned.push_back(unassigned.size());
+		}
+
+		/*
+		 * Tasks with long deadlines are the most likely to be feasible at the
+		 * lowest priority, so they are tried first (deadline monotonic order).
+		 */
+		std::stable_sort(unassigned.begin(), unassigned.end(), [&] (int a, int b) {
+			return _all.deadline[a] > _all.deadline[b];
+		});
+
+		/* assign the priority levels from the lowest to the highest one */
+		while (!unassigned.empty())
+		{
+			bool assigned = false;
+			for (size_t k=0; k<unassigned.size(); ++k)
+			{
+				_hp.clear();
+				for (size_t j=0; j<unassigned.size(); ++j)
+				{
+					if (j != k)
+						_hp.push_back(_all, unassigned[j]);
+				}
+
+				if (_response_time_ok(&_all, unassigned[k], &_hp, _hp.size()))
+				{
+					lowest_first.push_back(unassigned[k]);
+					unassigned.erase(unassigned.begin() + k);
+					assigned = true;
+					break;
+				}
+			}
+
+			if (!assigned)
+			{
+				SCHED_INF("Audsley: no task is feasible at priority level %d, Task-Set is NOT schedulable!", (int)unassigned.size() - 1);
+				return false;
+			}
+		}
+
+		order->clear();
+		order->reserve(lowest_first.size());
+		for (auto it = lowest_first.rbegin(); it != lowest_first.rend(); ++it)
+		{
+			order->push_back(*tasks[*it]);
+			order->back().prio = top_prio - (int)(order->size() - 1);
+		}
+		SCHED_INF("Audsley: found a feasible priority assignment for %d tasks", (int)order->size());
+		return true;
+	}
+
+
+	bool Sched_alg::_response_time_ok(Rq_view const *tasks, int check)
+	{
+		/*
+		 * As in the RTA, the tasks of equal priority interfere with
+		 * each other. They are adjacent, the ones after check are
+		 * added to the tasks before it.
+		 */
+		int end = check + 1;
+		while (end < tasks->size() && tasks->prio[end] == tasks->prio[check])
+		{
+			++end;
+		}
+		if (end == check + 1)
+		{
+			return _response_time_ok(tasks, check, tasks, check);
+		}
+
+		_hp.clear();
+		for (int j=0; j<end; ++j)
+		{
+			if (j != check)
+				_hp.push_back(*tasks, j);
+		}
+		return _response_time_ok(tasks, check, &_hp, _hp.size());
+	}
+
+
+	bool Sched_alg::task_set_schedulable(Rq_view const *tasks, int first_check)
+	{
+		/* a change of task first_check also affects the tasks of equal priority before it */
+		while (first_check > 0 && first_check < tasks->size() && tasks->prio[first_check - 1] == tasks->prio[first_check])
+		{
+			--first_check;
+		}
+		for (int i=first_check; i<tasks->size(); ++i)
+		{
+			if (!_response_time_ok(tasks, i))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	unsigned long long Sched_alg::response_time(Rq_view const *tasks, int index)
+	{
+		if (!_response_time_ok(tasks, index))
+		{
+			return 0;
+		}
+		return _response_time + tasks->jitter[index];
+	}
+
+
+	unsigned long long Sched_alg::wcet_hi(Rq_task::Rq_task *task)
+	{
+		if (task->task_class == Rq_task::Task_class::hi && task->wcet_hi > task->wcet)
+		{
+			return task->wcet_hi;
+		}
+		return task->wcet;
+	}
+
+
+	bool Sched_alg::amc_rtb(Rq_task::Rq_task *new_task, Rq_view const *view)
+	{
+		_all = *view;
+		int new_index = _all.insert(*new_task);
+		int num_tasks = _all.size();
+		_hp.reserve(num_tasks);
+
+		/*
+		 * Only the new task and the tasks it can interfere with need to be
+		 * checked, the others are assumed to be schedulable already.
+		 * Tasks of equal priority are counted as interference.
+		 */
+		for (int check=0; check<num_tasks; ++check)
+		{
+			if (check != new_index && _all.prio[check] > new_task->prio)
+			{
+				continue;
+			}
+
+			_hp.clear();
+			for (int j=0; j<num_tasks; ++j)
+			{
+				if (j != check && _all.prio[j] >= _all.prio[check])
+				{
+					_hp.push_back(_all, j);
+				}
+			}
+
+			if (!_amc_response_time_ok(&_all, check, &_hp, _hp.size()))
+			{
+				SCHED_INF("AMC: Task-Set is NOT schedulable because of task %s!", _all.name[check].str);
+				return false;
+			}
+		}
+		SCHED_INF("AMC: All tasks passed AMC-rtb -> Task-Set schedulable!");
+		return true;
+	}
+
+
+	/*
+	 * Release jitter shortens the window between the latest release
+	 * and the deadline, so the demand is computed with D - J.
+	 */
+	static unsigned long long edf_deadline(Rq_view const *tasks, int i)
+	{
+		return (tasks->deadline[i] > tasks->jitter[i]) ? tasks->deadline[i] - tasks->jitter[i] : 0;
+	}
+
+
+	unsigned long long Sched_alg::_edf_demand(Rq_view const *tasks, unsigned long long t)
+	{
+		int num_tasks = tasks->size();
+		unsigned long long demand = 0;
+		for (int i=0; i<num_tasks; ++i)
+		{
+			demand = std::max(demand, tasks->blocking[i]);
+		}
+		for (int i=0; i<num_tasks; ++i)
+		{
+			unsigned long long d = edf_deadline(tasks, i);
+			if (t >= d)
+			{
+				demand += ((t - d) / tasks->period[i] + 1) * tasks->wcet[i];
+			}
+		}
+		return demand;
+	}
+
+
+	bool Sched_alg::edf_schedulable(Rq_view const *tasks)
+	{
+		int num_tasks = tasks->size();
+		double util = 0.0;
+		bool implicit = true;
+		unsigned long long d_min = ~0ULL, d_max = 0, b_max = 0, wcet_sum = 0;
+		for (int i=0; i<num_tasks; ++i)
+		{
+			unsigned long long d = edf_deadline(tasks, i);
+			if (tasks->period[i] == 0 || tasks->wcet[i] > d)
 			{
-				PWRN("Deadline hit for new task %d, Task set might be not schedulable! Maybe try an exact test.", _curr_task->task_id);
 				return false;
 			}
-			PINF("Upper bound lower then deadline --> task-set is schedulable!");
+			util += (double)tasks->wcet[i] / (double)tasks->period[i];
+			implicit = implicit && d >= tasks->period[i];
+			d_min = std::min(d_min, d);
+			d_max = std::max(d_max, d);
+			b_max = std::max(b_max, tasks->blocking[i]);
+			wcet_sum += tasks->wcet[i];
+		}
+
+		if (util > 1.0)
+		{
+			return false;
+		}
+		if (num_tasks == 0 || (implicit && b_max == 0))
+		{
+			return true;
+		}
+
+		/*
+		 * Only deadlines up to L need to be checked. L is the smaller one of
+		 * the bound by George et al. and the synchronous busy period.
+		 */
+		unsigned long long l_a = ~0ULL;
+		if (util < 1.0)
+		{
+			double sum = (double)b_max;
+			for (int i=0; i<num_tasks; ++i)
+			{
+				if (tasks->period[i] > edf_deadline(tasks, i))
+				{
+					sum += (double)(tasks->period[i] - edf_deadline(tasks, i)) * tasks->wcet[i] / tasks->period[i];
+				}
+			}
+			l_a = std::max(d_max, (unsigned long long)ceil(sum / (1.0 - util)));
+		}
+
+		unsigned long long l_b = wcet_sum + b_max;
+		while (l_b < l_a)
+		{
+			if (!_spend(0))
+			{
+				return false;
+			}
+			unsigned long long next = b_max;
+			for (int i=0; i<num_tasks; ++i)
+			{
+				next += ((l_b + tasks->period[i] - 1) / tasks->period[i]) * tasks->wcet[i];
+			}
+			if (next == l_b)
+			{
+				break;
+			}
+			l_b = next;
+		}
+		unsigned long long l = std::min(l_a, l_b);
+
+		/* latest absolute deadline before t, 0 if there is none */
+		auto prev_deadline = [&] (unsigned long long t) {
+			unsigned long long prev = 0;
+			for (int i=0; i<num_tasks; ++i)
+			{
+				unsigned long long d = edf_deadline(tasks, i);
+				if (t > d)
+				{
+					prev = std::max(prev, d + ((t - d - 1) / tasks->period[i]) * tasks->period[i]);
+				}
+			}
+			return prev;
+		};
+
+		/* QPA walks backwards from L and skips all deadlines with enough slack */
+		unsigned long long t = prev_deadline(l + 1);
+		unsigned long long h = _edf_demand(tasks, t);
+		while (h <= t && h > d_min)
+		{
+			if (!_spend(0))
+			{
+				return false;
+			}
+			t = (h < t) ? h : prev_deadline(t);
+			h = _edf_demand(tasks, t);
+		}
+		return h <= d_min;
+	}
+
+
+	bool Sched_alg::edf_test(Rq_task::Rq_task *new_task, Rq_view const *view, Rq_util *util)
+	{
+		if (new_task->inter_arrival == 0 || new_task->wcet + new_task->jitter > new_task->deadline)
+		{
+			SCHED_WRN("Task %s can never meet its deadline", new_task->name);
+			return false;
+		}
+		if (util->utilization + (double)new_task->wcet / (double)new_task->inter_arrival > 1.0)
+		{
+			SCHED_INF("Utilization would exceed 100%%, Task-Set is NOT schedulable!");
+			return false;
+		}
+
+		_all = *view;
+		_all.push_back(*new_task);
+
+		if (!edf_schedulable(&_all))
+		{
+			SCHED_INF("EDF: processor demand exceeded, Task-Set is NOT schedulable!");
+			return false;
 		}
 		return true;
 	}
+
+
+	bool Sched_alg::_spend(unsigned long long bound)
+	{
+		if (_exhausted)
+		{
+			return false;
+		}
+		if ((_max_iterations && _iterations >= _max_iterations)
+		    || (_max_cycles && Genode::Trace::timestamp() - _start > _max_cycles))
+		{
+			SCHED_HOT("Analysis budget used up after %lu iterations, bound = %llu", _iterations, bound);
+			_exhausted = true;
+			_partial_bound = bound;
+			return false;
+		}
+		++_iterations;
+		return true;
+	}
+
+
+	void Sched_alg::budget(unsigned long iterations, unsigned long long cycles)
+	{
+		_max_iterations = iterations;
+		_max_cycles = cycles;
+		_start = cycles ? Genode::Trace::timestamp() : 0;
+		_iterations = 0;
+		_exhausted = false;
+		_partial_bound = 0;
+	}
+
+
+	unsigned long long Sched_alg::upper_bound(Rq_task::Rq_task *new_task, Rq_view const *view)
+	{
+		/* the bound of fp_sufficient_test, only for new_task */
+		int position = view->position(new_task->prio);
+		double sum_util = 0.0, sum_util_wcet = 0.0;
+		for (int i=0; i<position; ++i)
+		{
+			double util = (double)view->wcet[i] / (double)view->period[i];
+			sum_util += util;
+			sum_util_wcet += view->wcet[i] * (1 - util) + view->jitter[i] * util;
+		}
+		if (sum_util >= 1)
+		{
+			return ~0ULL;
+		}
+		return (unsigned long long)ceil(((double)new_task->wcet + (double)new_task->blocking + sum_util_wcet) / (1 - sum_util))
+		       + new_task->jitter;
+	}
+
+
+	void Sched_alg::cd_split(Rq_task::Rq_task const &task, unsigned long long budget, Rq_view const *view,
+	                         Rq_task::Rq_task *head, Rq_task::Rq_task *tail)
+	{
+		*head = task;
+		head->wcet = budget;
+		head->wcet_hi = 0;
+		head->deadline = budget + task.blocking + task.jitter;
+		head->prio = std::max(view->size() ? view->prio[0] : task.prio, task.prio) + 1;
+
+		/*
+		 * The head completes between C' and C' + B + J after the
+		 * release of task, which is the release jitter of the tail
+		 * relative to the earliest completion of the head.
+		 */
+		*tail = task;
+		tail->wcet = task.wcet - budget;
+		tail->wcet_hi = 0;
+		tail->jitter = task.jitter + task.blocking;
+		tail->deadline = (task.deadline > budget) ? task.deadline - budget : 0;
+	}
+
+
+	unsigned long long Sched_alg::cd_head_budget(Rq_task::Rq_task *task, Rq_view const *view)
+	{
+		if (task->wcet < 2 || task->inter_arrival == 0 || task->deadline <= task->blocking + task->jitter)
+		{
+			return 0;
+		}
+
+		/* the head has to leave at least one unit to the tail and has to fit its own deadline */
+		unsigned long long lo = 0;
+		unsigned long long hi = std::min(task->wcet - 1, task->deadline - task->blocking - task->jitter);
+		Rq_task::Rq_task head, tail;
+		while (lo < hi)
+		{
+			unsigned long long mid = lo + (hi - lo + 1) / 2;
+			cd_split(*task, mid, view, &head, &tail);
+			_all = *view;
+			_all.insert_at(0, head);
+			if (task_set_schedulable(&_all, 1))
+			{
+				lo = mid;
+			}
+			else
+			{
+				hi = mid - 1;
+			}
+		}
+		SCHED_HOT("C=D head budget of task %d is %llu of %llu", task->task_id, lo, task->wcet);
+		return lo;
+	}
 }
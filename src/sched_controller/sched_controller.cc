@@ -11,6 +11,7 @@
 #include <string>
 /* ******************************** */
 
+#include <algorithm>
 #include <forward_list>
 #include <unordered_map>
 #include <base/printf.h>
@@ -18,10 +19,14 @@
 /* for optimize function */
 #include <util/xml_node.h>
 #include <util/xml_generator.h>
+#include <os/config.h>
 #include <typeinfo>
 /* ******************************** */
 
 #include "sched_controller/sched_controller.h"
+#include "sched_controller/log.h"
+#include "sched_controller/stats.h"
+#include "sched_controller/trace.h"
 #include "sched_controller/task_allocator.h"
 #include "sched_controller/monitor.h"
 #include "mon_manager/mon_manager.h"
@@ -43,7 +48,7 @@ namespace Sched_controller {
 	int Sched_controller::_init_rqs(int rq_size)
 	{
 
-		_rqs = new Rq_buffer<Rq_task::Rq_task>[_num_cores];
+		_rqs = new Rq_buffer<Rq_task::Rq_entry>[_num_cores];
 
 		for (int i = 0; i < _num_cores; i++) {
 			//_rqs[i].init_w_shared_ds(rq_size);
@@ -66,45 +71,779 @@ namespace Sched_controller {
 	 */
 	int Sched_controller::enq(int core, Rq_task::Rq_task task)
 	{
-		PINF("Task with name %s, is now enqueued to run queue %d", task.name, core);
+		int result = _admission(core, task, true);
+		_count_verdict(core, result);
+		return result;
+	}
+
+	/**
+	 * Admission of enq() with its trace events and latency,
+	 * the verdict is counted by the caller
+	 *
+	 * \param reassign: false to keep the priorities of the
+	 *        run queue even with Audsley's priority assignment
+	 */
+	int Sched_controller::_admission(int core, Rq_task::Rq_task task, bool reassign)
+	{
+		_complete_admissions();
+		_apply_wcet_estimates();
+
+		if (Sched_trace::tracer() && core >= 0)
+			Sched_trace::tracer()->core(core);
+		fp_alg.core(core);
+		SCHED_TRACE(ADMISSION_BEGIN, core, task.task_id, task.name, task.prio, task.deadline);
+		Genode::Trace::Timestamp start = Genode::Trace::timestamp();
+
+		int result = _admit(core, task, reassign);
+
+		SCHED_STAT_LATENCY(core, admission_hist, Genode::Trace::timestamp() - start);
+		SCHED_TRACE(ADMISSION_END, core, task.task_id, task.name, result, 0);
+		return result;
+	}
+
+	void Sched_controller::_count_verdict(int core, int status)
+	{
+		if (status == 0)
+			SCHED_STAT_INC(core, admitted);
+		else
+			SCHED_STAT_INC(core, rejected);
+	}
+
+	/**
+	 * Run the admission test of the run queue of the task
+	 * and enqueue it if it passes, see enq() and _admission()
+	 */
+	int Sched_controller::_admit(int core, Rq_task::Rq_task task, bool reassign)
+	{
+		SCHED_INF("Task with name %s, is now enqueued to run queue %d", task.name, core);
 
-		if (core < _num_cores)
+		if (core >= 0 && core < _num_cores)
 		{
 			task_map.insert({task.name, task});
-			if(task.task_class == Rq_task::Task_class::hi)
+			bool rate_monotonic = _rq_util[core].rate_monotonic && fp_alg.rate_monotonic(&task, &_rq_view[core]);
+
+			//The same test on the declared wcet as in the pool and the background admission:
+			//AMC-rtb with mixed criticality, EDF or the cascade of sufficient tests before the RTA for hi tasks
+			Admission_pool::Test test = _test_of(task);
+			if (!Admission_pool::admissible(fp_alg, test, task, _rq_view[core], _rq_util[core]))
 			{
-				//Execute sufficient schedulability test
-				if (!fp_alg.fp_sufficient_test(&task, &_rqs[core]))
+				if (test != Admission_pool::Test::fp || _admission_mode != Admission_mode::audsley || !reassign)
 				{
-					//If sufficient test fails --> execute RTA (exact test)
-					if (!fp_alg.RTA(&task, &_rqs[core]))
-					{
-						return -1;
-					}
+					SCHED_HOT_DUMP();
+					return -1;
+				}
+
+				//The supplied priority does not work, look for another priority order
+				std::vector<Rq_task::Rq_task> order, rq_tasks;
+				_tasks_of(core, &rq_tasks);
+				if (!fp_alg.audsley(&task, &rq_tasks, &order))
+				{
+					SCHED_HOT_DUMP();
+					return -1;
 				}
-				PWRN("Sched_controller (enq): Task %s was rta analyzed", task.name);
+				SCHED_INF("Sched_controller (enq): Task %s was admitted with reassigned priorities", task.name);
+				return _rewrite_rq(core, &order);
 			}
-			else if (task.task_class == Rq_task::Task_class::lo)
+
+			if (task.task_class == Rq_task::Task_class::lo)
 			{
 				// do task optimization for lo tasks
 				_optimizer->add_task((unsigned int) core, task);
 			}
-			else
+			else if (task.task_class != Rq_task::Task_class::hi)
 			{
-				PWRN("Sched_controller (enq): The task_class of task %s is neither hi nor lo. It is: %d", task.name, task.task_class);
+				SCHED_WRN("Sched_controller (enq): The task_class of task %s is neither hi nor lo. It is: %d", task.name, (int)task.task_class);
 			}
-			int success = _rqs[core].enq(task);
-			
-			return success;
+			return _commit(core, task, rate_monotonic);
 		}
 		else
 		{
-			PWRN("Sched_controller (enq): At task %s, the core (%d) is larger or equal than the number of cores (%d)", task.name, core, _num_cores);
+			SCHED_WRN("Sched_controller (enq): At task %s, the core (%d) is not one of the %d cores", task.name, core, _num_cores);
 		}
 		
 		return -1;
 	}
 
+	/**
+	 * Enqueue a task that passed the admission test and account
+	 * it in the aggregates and the view of its run queue
+	 *
+	 * \return  0 if successful
+	 *         >0 the Rq_buffer status in any other case
+	 */
+	int Sched_controller::_commit(int core, Rq_task::Rq_task task, bool rate_monotonic)
+	{
+		int success = _enq(core, task);
+		if (success == 0)
+		{
+			_account(core, task, rate_monotonic);
+			_invalidate(core);
+			_mirror[core].pending.insert(task.name);
+		}
+		else
+		{
+			_count_rq_error(core, success);
+		}
+		return success;
+	}
+
+	/**
+	 * Task as it is accounted to place lo tasks: lo tasks with
+	 * their estimated wcet if the estimation is on, see
+	 * Wcet_estimator. Lo jobs may exceed the estimate, so every
+	 * admission test and the Rq_buffer keep the declared wcet.
+	 */
+	Rq_task::Rq_task Sched_controller::_effective(Rq_task::Rq_task task)
+	{
+		if (_estimator && task.task_class == Rq_task::Task_class::lo)
+		{
+			task.wcet = _estimator->effective(task.name, task.wcet);
+		}
+		return task;
+	}
+
+	/**
+	 * Account an enqueued task in the aggregates and the view of its
+	 * run queue, and with its estimated wcet in _rq_estimate
+	 */
+	void Sched_controller::_account(int core, Rq_task::Rq_task task, bool rate_monotonic)
+	{
+		fp_alg.add_util(&_rq_util[core], &task, rate_monotonic);
+		_rq_view[core].insert(task);
+		if (_estimator)
+		{
+			_rq_estimate[core].insert(_effective(task));
+		}
+	}
+
+	/**
+	 * Forget the accounted tasks of a core before its run queue is rebuilt
+	 */
+	void Sched_controller::_reset_analysis(int core)
+	{
+		Sched_alg::reset_util(&_rq_util[core]);
+		_rq_view[core].clear();
+		_rq_estimate[core].clear();
+		_invalidate(core);
+	}
+
+	/**
+	 * Drop the cached slack and headroom of a core after its run queue changed
+	 */
+	void Sched_controller::_invalidate(int core)
+	{
+		_sensitivity->invalidate(core);
+		if (_estimate_sensitivity)
+		{
+			_estimate_sensitivity->invalidate(core);
+		}
+	}
+
+	/**
+	 * Rebuild _rq_estimate of the run queues that hold a task
+	 * whose estimated wcet has changed. A lower estimate only
+	 * makes room for lo tasks that are placed later.
+	 */
+	void Sched_controller::_apply_wcet_estimates()
+	{
+		if (!_estimator) {
+			return;
+		}
+
+		std::vector<std::string> changed;
+		_estimator->take_changed(&changed);
+		if (changed.empty()) {
+			return;
+		}
+
+		for (int core = 0; core < _num_cores; core++) {
+			bool affected = false;
+			for (int i = 0; i < _rq_estimate[core].size() && !affected; i++) {
+				for (auto &name : changed) {
+					if (name == _rq_estimate[core].name[i].str) {
+						affected = true;
+						break;
+					}
+				}
+			}
+			if (!affected) {
+				continue;
+			}
+
+			_rq_estimate[core].clear();
+			for (int i = 0; i < _rqs[core].get_num_elements(); i++) {
+				_rq_estimate[core].insert(_effective(_task_at(core, i)));
+			}
+			_estimate_sensitivity->invalidate(core);
+			SCHED_INF("Sched_controller: lo tasks are placed on run queue %d with new wcet estimates", core);
+		}
+	}
+
+	/**
+	 * Admission test of a task as chosen by _admit
+	 */
+	Admission_pool::Test Sched_controller::_test_of(Rq_task::Rq_task const &task)
+	{
+		if (_mixed_criticality) {
+			return Admission_pool::Test::amc;
+		}
+		if (task.task_class == Rq_task::Task_class::hi && task.task_strategy == Rq_task::Task_strategy::deadline) {
+			return Admission_pool::Test::edf;
+		}
+		if (task.task_class == Rq_task::Task_class::hi) {
+			return Admission_pool::Test::fp;
+		}
+		return Admission_pool::Test::none;
+	}
+
+	/**
+	 * Split a hi task that fits on no single core over two of the
+	 * given cores, see Sched_alg::cd_split(). The head goes to the
+	 * core that takes the largest share of the task, the tail to the
+	 * first other core that admits it. Both portions keep the name
+	 * and the id of the task, they are the same thread.
+	 *
+	 * \return  0 if both portions were enqueued
+	 *         <0 in any other case
+	 */
+	int Sched_controller::split_task(Rq_task::Rq_task *task, std::vector<int> const &cores)
+	{
+		if (_test_of(*task) != Admission_pool::Test::fp) {
+			SCHED_INF("Task %s is not split, C=D splitting is only analysed for fixed priorities", task->name);
+			return -1;
+		}
+
+		std::vector<std::pair<unsigned long long, int>> heads; /* head budget, core */
+		for (int core : cores) {
+			unsigned long long budget = fp_alg.cd_head_budget(task, &_rq_view[core]);
+			if (budget > 0) {
+				heads.push_back({ budget, core });
+			}
+		}
+		std::stable_sort(heads.begin(), heads.end(), [] (std::pair<unsigned long long, int> const &a,
+		                                                 std::pair<unsigned long long, int> const &b) {
+			return a.first > b.first;
+		});
+
+		for (auto &h : heads) {
+			Rq_task::Rq_task head, tail;
+			Sched_alg::cd_split(*task, h.first, &_rq_view[h.second], &head, &tail);
+
+			for (int core : cores) {
+				if (core == h.second) {
+					continue;
+				}
+				Rq_util util = _rq_util[core];
+				bool rate_monotonic = util.rate_monotonic && fp_alg.rate_monotonic(&tail, &_rq_view[core]);
+				fp_alg.core(core);
+				if (!fp_alg.fp_admission_test(&tail, &_rq_view[core], &util, rate_monotonic)) {
+					continue;
+				}
+
+				/*
+				 * Both portions were analysed with the priorities of the
+				 * run queues, Audsley must not reassign them. If the tail
+				 * cannot be enqueued, the head is taken out again.
+				 */
+				int status = _admission(h.second, head, false);
+				_count_verdict(h.second, status);
+				if (status != 0) {
+					SCHED_WRN("Sched_controller: the head of task %s could not be enqueued (%d)", task->name, status);
+					return -1;
+				}
+				status = _admission(core, tail, false);
+				_count_verdict(core, status);
+				if (status != 0) {
+					SCHED_WRN("Sched_controller: the tail of task %s could not be enqueued (%d)", task->name, status);
+					_dequeue(h.second, task->name);
+					_mirror[h.second].pending.erase(task->name);
+					task_map.erase(task->name);
+					return -1;
+				}
+				_split[task->name] = { h.second, head, core, tail };
+				SCHED_INF("Task %s is split: %llu on core %d, %llu on core %d", task->name, head.wcet, h.second, tail.wcet, core);
+				return 0;
+			}
+		}
+
+		SCHED_INF("Task %s fits on no pair of cores either", task->name);
+		return -1;
+	}
+
+	/**
+	 * Enqueue a task within an analysis budget, see admission.h.
+	 * If the budget runs out, the task is rejected or, with
+	 * budget_verdict="provisional", admitted provisionally and
+	 * analysed without a budget in the background.
+	 */
+	Admission_result Sched_controller::admit(int core, Rq_task::Rq_task task, Admission_budget budget)
+	{
+		Admission_result result { };
+		result.verdict = Admission_result::REJECTED;
+		result.status = -1;
+		result.upper_bound = ~0ULL;
+
+		/* the allocator has no budget, the client has to choose the core */
+		if (core < 0 || core >= _num_cores) {
+			SCHED_WRN("Sched_controller (admit): At task %s, the core (%d) is not one of the %d cores", task.name, core, _num_cores);
+			return result;
+		}
+		result.upper_bound = Sched_alg::upper_bound(&task, &_rq_view[core]);
+
+		fp_alg.budget(budget.iterations, budget.cycles);
+		result.status = _admission(core, task, true);
+		result.exhausted = fp_alg.exhausted();
+		result.iterations = fp_alg.iterations();
+		result.lower_bound = fp_alg.partial_bound();
+		fp_alg.budget(0, 0);
+
+		if (result.status == 0) {
+			result.verdict = Admission_result::ADMITTED;
+		} else if (result.exhausted && _background) {
+			/* counted once the background analysis is complete */
+			result.verdict = Admission_result::PROVISIONAL;
+			_provisional[task.name] = result;
+			/* the task as _admission analysed it, see _admit */
+			_background->submit({ core, task, _test_of(task), _rq_view[core], _rq_util[core], false });
+			SCHED_INF("Task %s is admitted provisionally after %lu iterations", task.name, result.iterations);
+			return result;
+		}
+		_count_verdict(core, result.status);
+		return result;
+	}
+
+	/**
+	 * Result of a provisional admission. A final result is
+	 * returned once and then forgotten, an unknown task is
+	 * reported as rejected. Only the last MAX_FINISHED final
+	 * results are kept for clients that never ask.
+	 */
+	Admission_result Sched_controller::admission_result(std::string task_name)
+	{
+		_complete_admissions();
+
+		Admission_result result { };
+		result.verdict = Admission_result::REJECTED;
+		result.status = -1;
+
+		auto it = _provisional.find(task_name);
+		if (it != _provisional.end()) {
+			result = it->second;
+			if (result.verdict != Admission_result::PROVISIONAL) {
+				_provisional.erase(it);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Enqueue the tasks whose analysis the background thread has
+	 * finished. The analysis only holds for the snapshot, so a
+	 * task whose run queue changed meanwhile is analysed again.
+	 */
+	void Sched_controller::_complete_admissions()
+	{
+		if (!_background) {
+			return;
+		}
+
+		std::list<Background_admission::Job> done;
+		_background->take_done(&done);
+		for (auto &job : done) {
+			auto it = _provisional.find(job.task.name);
+			if (it == _provisional.end()) {
+				continue;
+			}
+
+			int core = job.core;
+			if (job.admissible && job.view.generation != _rq_view[core].generation) {
+				job.view = _rq_view[core];
+				job.util = _rq_util[core];
+				_background->submit(job);
+				continue;
+			}
+
+			it->second.status = -1;
+			if (job.admissible) {
+				bool rate_monotonic = _rq_util[core].rate_monotonic && fp_alg.rate_monotonic(&job.task, &_rq_view[core]);
+				if (job.task.task_class == Rq_task::Task_class::lo) {
+					_optimizer->add_task((unsigned int) core, job.task);
+				}
+				it->second.status = _commit(core, job.task, rate_monotonic);
+			} else if (job.test == Admission_pool::Test::fp && _admission_mode == Admission_mode::audsley) {
+				/* the supplied priority does not work, as in _admit look for another priority order */
+				std::vector<Rq_task::Rq_task> order, rq_tasks;
+				_tasks_of(core, &rq_tasks);
+				fp_alg.core(core);
+				if (fp_alg.audsley(&job.task, &rq_tasks, &order)) {
+					it->second.status = _rewrite_rq(core, &order);
+				}
+			}
+			it->second.verdict = (it->second.status == 0) ? Admission_result::ADMITTED : Admission_result::REJECTED;
+			_count_verdict(core, it->second.status);
+			SCHED_INF("Provisional admission of task %s is %s", job.task.name,
+			          (it->second.status == 0) ? "confirmed" : "rejected");
+
+			_finished.push_back(job.task.name);
+			if (_finished.size() > MAX_FINISHED) {
+				auto oldest = _provisional.find(_finished.front());
+				if (oldest != _provisional.end() && oldest->second.verdict != Admission_result::PROVISIONAL) {
+					_provisional.erase(oldest);
+				}
+				_finished.pop_front();
+			}
+		}
+	}
+
+	/**
+	 * Enqueue a task in the Rq_buffer of a core and remember
+	 * its position for remove_task()
+	 */
+	int Sched_controller::_enq(int core, Rq_task::Rq_task const &task)
+	{
+		int success = _rqs[core].enq(task);
+		if (success == 0)
+		{
+			_occupy(core, task, _rqs[core].get_num_elements() - 1);
+		}
+		return success;
+	}
+
+	/**
+	 * Remember the position of a task in the Rq_buffer of a
+	 * core and account it in the run queue that hosts it
+	 */
+	void Sched_controller::_occupy(int core, Rq_task::Rq_task const &task, int position)
+	{
+		int runqueue = _host_runqueue(core, task);
+		_slots[core][task.name] = { position, runqueue, task };
+		if (runqueue >= 0)
+		{
+			_runqueue[runqueue].num_tasks++;
+		}
+	}
+
+	/**
+	 * Rebuild the positions of a core after its
+	 * Rq_buffer was changed from the head
+	 */
+	void Sched_controller::_index_slots(int core)
+	{
+		std::unordered_map<std::string, Rq_slot> slots;
+		slots.swap(_slots[core]);
+		for (int i = 0; i < _rqs[core].get_num_elements(); i++)
+		{
+			Rq_task::Rq_entry *entry = _rqs[core].get_element(i);
+			auto old = slots.find(entry->name);
+			Rq_task::Rq_task task { };
+			if (old != slots.end())
+			{
+				task = old->second.task;
+			}
+			static_cast<Rq_task::Rq_entry &>(task) = *entry;
+			_slots[core][entry->name] = { i, (old != slots.end()) ? old->second.runqueue : -1, task };
+		}
+	}
+
+	/**
+	 * Task at position i of the Rq_buffer of a core, together
+	 * with the parameters it was enqueued with that only the
+	 * analysis uses
+	 */
+	Rq_task::Rq_task Sched_controller::_task_at(int core, int i)
+	{
+		Rq_task::Rq_entry *entry = _rqs[core].get_element(i);
+		Rq_task::Rq_task task { };
+		auto slot = _slots[core].find(entry->name);
+		if (slot != _slots[core].end())
+		{
+			task = slot->second.task;
+		}
+		static_cast<Rq_task::Rq_entry &>(task) = *entry;
+		return task;
+	}
+
+	/**
+	 * All tasks of the Rq_buffer of a core, in its order
+	 */
+	void Sched_controller::_tasks_of(int core, std::vector<Rq_task::Rq_task> *tasks)
+	{
+		tasks->clear();
+		tasks->reserve(_rqs[core].get_num_elements());
+		for (int i = 0; i < _rqs[core].get_num_elements(); i++)
+		{
+			tasks->push_back(_task_at(core, i));
+		}
+	}
+
+	/**
+	 * Forget the positions of a core before its Rq_buffer is
+	 * rebuilt. Its run queues are kept, even if they are empty.
+	 */
+	void Sched_controller::_clear_slots(int core)
+	{
+		for (auto &slot : _slots[core])
+		{
+			if (slot.second.runqueue >= 0 && _runqueue[slot.second.runqueue].num_tasks > 0)
+			{
+				_runqueue[slot.second.runqueue].num_tasks--;
+			}
+		}
+		_slots[core].clear();
+	}
+
+	/**
+	 * Run queue that accounts a task of a core: the one of its
+	 * class and strategy, the lo priority one, which also hosts
+	 * hi tasks, or a new one of its class and strategy
+	 *
+	 * \return index in _runqueue, -1 if there is none
+	 */
+	int Sched_controller::_host_runqueue(int core, Rq_task::Rq_task const &task)
+	{
+		int index = _rq_index[_rq_key(core, task.task_class, task.task_strategy)];
+		if (index < 0)
+		{
+			index = _rq_index[_rq_key(core, Rq_task::Task_class::lo, Rq_task::Task_strategy::priority)];
+		}
+		if (index < 0)
+		{
+			index = create_runqueue(core, task.task_class, task.task_strategy, true);
+		}
+		return index;
+	}
+
+	/**
+	 * Take a task out of the run queue of a core. The aggregates
+	 * and the view are updated with the wcet the task was
+	 * accounted with, the other tasks keep their analysis. The
+	 * tasks behind it move up in the Rq_buffer, so their positions
+	 * are updated, which is linear in the length of the run queue.
+	 *
+	 * \return  0 if successful
+	 *         <0 if the run queue does not hold the task
+	 *         >0 the Rq_buffer status in any other case
+	 */
+	int Sched_controller::_dequeue(int core, std::string const &name)
+	{
+		auto slot = _slots[core].find(name);
+		if (slot == _slots[core].end())
+		{
+			return -1;
+		}
+
+		int n = slot->second.position;
+		int runqueue = slot->second.runqueue;
+		Rq_task::Rq_task task = _task_at(core, n);
+		int success = _rqs[core].remove(n);
+		if (success != 0)
+		{
+			_count_rq_error(core, success);
+			return success;
+		}
+		_slots[core].erase(slot);
+		for (int i = n; i < _rqs[core].get_num_elements(); i++)
+		{
+			_slots[core][_rqs[core].get_element(i)->name].position = i;
+		}
+		if (runqueue >= 0 && --_runqueue[runqueue].num_tasks == 0 && _runqueue[runqueue].on_demand)
+		{
+			destroy_runqueue(runqueue);
+		}
+
+		int index = _rq_view[core].find(task);
+		if (index >= 0)
+		{
+			task.wcet = _rq_view[core].wcet[index];
+			_rq_view[core].erase(index);
+			Sched_alg::remove_util(&_rq_util[core], &task);
+		}
+		index = _rq_estimate[core].find(task);
+		if (index >= 0)
+		{
+			_rq_estimate[core].erase(index);
+		}
+		_invalidate(core);
+		return 0;
+	}
+
+	/**
+	 * Take a task out of every run queue that holds it, a split
+	 * task out of both, and forget it
+	 *
+	 * \return  0 if the task was removed from at least one run queue
+	 *         <0 if no run queue holds it
+	 *         >0 the Rq_buffer status in any other case, then the
+	 *            task is kept in all run queues that held it
+	 */
+	int Sched_controller::_release(std::string const &name)
+	{
+		/* the run queues that gave up the task, they get it back if a later one is locked */
+		std::vector<std::pair<int, std::vector<Rq_task::Rq_task>>> released;
+		for (int core = 0; core < _num_cores; core++)
+		{
+			if (_slots[core].find(name) == _slots[core].end())
+			{
+				continue;
+			}
+
+			std::vector<Rq_task::Rq_task> order;
+			_tasks_of(core, &order);
+
+			int success = _dequeue(core, name);
+			if (success != 0)
+			{
+				for (auto &rq : released)
+				{
+					if (_rewrite_rq(rq.first, &rq.second) != 0)
+					{
+						SCHED_ERR("Task %s could not be restored in run queue %d", name.c_str(), rq.first);
+					}
+				}
+				return success;
+			}
+			released.push_back({ core, std::move(order) });
+		}
+
+		for (auto &rq : released)
+		{
+			SCHED_INF("Task %s was removed from run queue %d", name.c_str(), rq.first);
+			_mirror[rq.first].pending.erase(name);
+		}
+
+		task_map.erase(name);
+		_split.erase(name);
+		_provisional.erase(name);
+		if (_estimator)
+		{
+			_estimator->forget(name);
+		}
+		return released.empty() ? -1 : 0;
+	}
+
+	/**
+	 * Remove a task that has departed, its capacity is
+	 * available to the next admission right away
+	 *
+	 * \return  0 if successful
+	 *         <0 if the task is unknown
+	 *         >0 the Rq_buffer status in any other case
+	 */
+	int Sched_controller::remove_task(std::string task_name)
+	{
+		int result = _release(task_name);
+		if (result > 0)
+		{
+			return result;
+		}
+
+		/* the optimizer forgets the task without reporting it back */
+		_optimizer->remove_task(task_name);
+		return result;
+	}
+
+	void Sched_controller::departed(std::string const &task_name, Cause_of_death cause)
+	{
+		SCHED_INF("Task %s has %s", task_name.c_str(), (cause == FINISHED) ? "finished" : "been killed");
+		_release(task_name);
+	}
+
+	/**
+	 * Replace the content of a run queue, e.g. after the
+	 * priorities have been reassigned
+	 *
+	 * \param core: run queue that is rebuilt
+	 * \param order: all tasks of the run queue, sorted
+	 *        from the highest to the lowest priority
+	 *
+	 * \return  0 if successful
+	 *         >0 the Rq_buffer status in any other case,
+	 *            then the run queue is left as it was
+	 */
+	int Sched_controller::_rewrite_rq(int core, std::vector<Rq_task::Rq_task> *order)
+	{
+		/* the Rq_buffer is replaced in one step, it keeps its content if that fails */
+		std::vector<Rq_task::Rq_entry> entries(order->begin(), order->end());
+		int success = _rqs[core].assign(entries.data(), entries.size());
+		if (success != 0)
+		{
+			_count_rq_error(core, success);
+			return success;
+		}
+		_clear_slots(core);
+		_mirror[core].synced = false;
+		_reset_analysis(core);
+
+		for (int i = 0; i < (int)order->size(); i++)
+		{
+			Rq_task::Rq_task task = (*order)[i];
+			bool rate_monotonic = _rq_util[core].rate_monotonic && fp_alg.rate_monotonic(&task, &_rq_view[core]);
+			_occupy(core, task, i);
+			_account(core, task, rate_monotonic);
+
+			auto it = task_map.find(task.name);
+			if (it != task_map.end())
+			{
+				it->second.prio = task.prio;
+			}
+			auto split = _split.find(task.name);
+			if (split != _split.end())
+			{
+				if (split->second.head_core == core)
+					split->second.head.prio = task.prio;
+				if (split->second.tail_core == core)
+					split->second.tail.prio = task.prio;
+			}
+		}
+
+		_mirror[core].committed.clear();
+		for (auto &task : *order)
+		{
+			_mirror[core].committed.push_back(task.name);
+		}
+		return 0;
+	}
+
+	/**
+	 * The rebuild after a rewrite has to keep the priority order
+	 * that was committed, otherwise the run queue is analysed on an
+	 * order that may be infeasible. Tasks that arrived or left
+	 * meanwhile are not compared.
+	 */
+	void Sched_controller::_check_committed_order(int core)
+	{
+		std::vector<std::string> &committed = _mirror[core].committed;
+		if (committed.empty())
+		{
+			return;
+		}
+
+		std::unordered_set<std::string> in_view;
+		for (int i = 0; i < _rq_view[core].size(); i++)
+		{
+			in_view.insert(_rq_view[core].name[i].str);
+		}
+		std::unordered_set<std::string> in_committed(committed.begin(), committed.end());
+
+		std::vector<std::string> expected, rebuilt;
+		for (auto &name : committed)
+		{
+			if (in_view.count(name))
+				expected.push_back(name);
+		}
+		for (int i = 0; i < _rq_view[core].size(); i++)
+		{
+			if (in_committed.count(_rq_view[core].name[i].str))
+				rebuilt.push_back(_rq_view[core].name[i].str);
+		}
+
+		if (expected != rebuilt)
+		{
+			SCHED_ERR("Run queue %d was rebuilt in another priority order than it was admitted with", core);
+		}
+		committed.clear();
+	}
+
 	/**
 	 * Dequeue a task from a given run queue
 	 *
@@ -113,12 +852,13 @@ namespace Sched_controller {
 	 * \param **task_ptr: pointer that will be set
 	 *        to the location where the task is stored
 	 */
-	int Sched_controller::deq(int core, Rq_task::Rq_task **task_ptr)
+	int Sched_controller::deq(int core, Rq_task::Rq_entry **task_ptr)
 	{
 
 		if (core < _num_cores) {
 			int success = _rqs[core].deq(task_ptr);
-			PINF("Removed task from core %d, pointer is %p", core, *task_ptr);
+			SCHED_INF("Removed task from core %d, pointer is %p", core, *task_ptr);
+			_index_slots(core);
 			return success;
 		}
 
@@ -127,11 +867,16 @@ namespace Sched_controller {
 
 	void Sched_controller::init_ds(int num_rqs, int num_cores)
 	{
-		int ds_size = num_cores*(4 * sizeof(int)) + (num_rqs * sizeof(Rq_task::Rq_task));
-		_rqs = new Rq_buffer<Rq_task::Rq_task>[num_cores];
+		int ds_size = num_cores*(4 * sizeof(int)) + (num_rqs * sizeof(Rq_task::Rq_entry));
+		_rqs = new Rq_buffer<Rq_task::Rq_entry>[num_cores];
 		for (int i = 0; i < num_cores; i++) {
 			sync_ds_cap_vector.emplace_back(Genode::env()->ram_session()->alloc(ds_size));
 			_rqs[i].init_w_shared_ds(sync_ds_cap_vector.back());
+			if (i < _num_cores) {
+				_reset_analysis(i);
+				_clear_slots(i);
+				_mirror[i] = Rq_mirror();
+			}
 		}
 	}
 
@@ -140,7 +885,7 @@ namespace Sched_controller {
 		PDBG("Got ds cap\n");
 		_num_cores=1;
 		sync_ds_cap=ds_cap;
-		_rqs = new Rq_buffer<Rq_task::Rq_task>[_num_cores];
+		_rqs = new Rq_buffer<Rq_task::Rq_entry>[_num_cores];
 		for (int i = 0; i < _num_cores; i++) {
 			//_rqs[i].init_w_shared_ds(sync_ds_cap);
 		}
@@ -170,6 +915,45 @@ namespace Sched_controller {
 		return 0;
 	}
 
+	/**
+	 * Read the admission settings from the config ROM, e.g.
+	 * <config admission="audsley"/>
+	 */
+	void Sched_controller::_read_config()
+	{
+		try {
+			Genode::String<16> mode = Genode::config()->xml_node().attribute_value("admission", Genode::String<16>("fixed"));
+			if (!Genode::strcmp(mode.string(), "audsley")) {
+				_admission_mode = Admission_mode::audsley;
+			}
+
+			Genode::String<16> criticality = Genode::config()->xml_node().attribute_value("criticality", Genode::String<16>("none"));
+			_mixed_criticality = !Genode::strcmp(criticality.string(), "amc");
+
+			_opt_trace_size = Genode::config()->xml_node().attribute_value("opt_trace", Genode::Number_of_bytes(0));
+			_trace_size = Genode::config()->xml_node().attribute_value("trace", Genode::Number_of_bytes(0));
+			_allocation_workers = Genode::config()->xml_node().attribute_value("allocation_workers", 0L);
+
+			Genode::String<24> placement = Genode::config()->xml_node().attribute_value("placement", Genode::String<24>("partitioned"));
+			_semi_partitioned = !Genode::strcmp(placement.string(), "semi_partitioned");
+
+			Genode::String<16> budget_verdict = Genode::config()->xml_node().attribute_value("budget_verdict", Genode::String<16>("reject"));
+			_provisional_admission = !Genode::strcmp(budget_verdict.string(), "provisional");
+
+			Genode::String<8> wcet_estimate = Genode::config()->xml_node().attribute_value("wcet_estimate", Genode::String<8>("off"));
+			_wcet_estimation = !Genode::strcmp(wcet_estimate.string(), "on");
+			_wcet_config.quantile = Genode::config()->xml_node().attribute_value("wcet_quantile", _wcet_config.quantile);
+			_wcet_config.margin = Genode::config()->xml_node().attribute_value("wcet_margin", _wcet_config.margin);
+			_wcet_config.min_samples = Genode::config()->xml_node().attribute_value("wcet_samples", _wcet_config.min_samples);
+		} catch (...) {
+			PWRN("Sched_controller: no valid config, using fixed priorities for admission");
+		}
+		PINF("Admission mode is %s%s%s%s", (_admission_mode == Admission_mode::audsley) ? "audsley" : "fixed",
+		     _mixed_criticality ? ", mixed-criticality analysis is AMC-rtb" : "",
+		     _semi_partitioned ? ", tasks are split if no core fits" : "",
+		     _wcet_estimation ? ", lo tasks are accounted with estimated wcets" : "");
+	}
+
 	/**
 	 * Initialize the pcores, i.e. create new
 	 * instances of the pcore class
@@ -189,35 +973,111 @@ namespace Sched_controller {
 	}
 
 	/**
-	 * Initialize the run queues
+	 * Initialize the run queues, by default one for lo tasks with
+	 * fixed priorities per pcore. The config may set up others, e.g.
+	 * <runqueue core="1" class="hi" strategy="deadline"/>. Further
+	 * run queues are created on demand.
 	 *
 	 * \return success status
 	 */
 	int Sched_controller::_init_runqueues()
 	{
+		_rq_index.assign(_num_pcores * NUM_KINDS, -1);
+		_rqs_on_pcore.assign(_num_pcores, 0);
+
+		try {
+			Genode::config()->xml_node().for_each_sub_node("runqueue", [&] (Genode::Xml_node node) {
+				long core = node.attribute_value("core", -1L);
+				Genode::String<8> task_class = node.attribute_value("class", Genode::String<8>("lo"));
+				Genode::String<16> strategy = node.attribute_value("strategy", Genode::String<16>("priority"));
+				create_runqueue(core,
+				                Genode::strcmp(task_class.string(), "hi") ? Rq_task::Task_class::lo : Rq_task::Task_class::hi,
+				                Genode::strcmp(strategy.string(), "deadline") ? Rq_task::Task_strategy::priority : Rq_task::Task_strategy::deadline);
+			});
+		} catch (...) { }
+
+		if (get_num_rqs() == 0) {
+			for (int i = 0; i < _num_pcores; i++) {
+				create_runqueue(i, Rq_task::Task_class::lo, Rq_task::Task_strategy::priority);
+			}
+		}
+		PINF("Number of initial run queues is: %d", get_num_rqs());
 
-		/* currently this is pretty stupid and
-		 * not what we actually want.
-		 */
+		return 0;
+	}
 
-		/* For the final implementation it is actually planned
-		 * to initialize the run queues dynamically, but therefore
-		 * the rq_manager has to be changed accordingly. At the
-		 * moment the rq_manager is configured to provide a fixed
-		 * number of run queues.
-		 */
-		//_num_rqs = _rq_manager.get_num_rqs();
-		PINF("Number of supplied run queues is: %d", _num_rqs);
+	int Sched_controller::_kind(Rq_task::Task_class task_class, Rq_task::Task_strategy task_strategy)
+	{
+		return (task_class == Rq_task::Task_class::hi ? 2 : 0) + (task_strategy == Rq_task::Task_strategy::deadline ? 1 : 0);
+	}
 
-		_runqueue = new Runqueue[_num_rqs];
+	int Sched_controller::_rq_key(int pcore, Rq_task::Task_class task_class, Rq_task::Task_strategy task_strategy)
+	{
+		return pcore * NUM_KINDS + _kind(task_class, task_strategy);
+	}
 
-		for (int i = 0; i < _num_pcores; i++) {
-			_runqueue[i]._task_class = Rq_task::Task_class::lo;
-			_runqueue[i]._task_strategy = Rq_task::Task_strategy::priority;
-			_runqueue[i].rq_buffer = i;
+	/**
+	 * Create a run queue for tasks of a class and strategy on a
+	 * pcore. It shares the Rq_buffer and the analysis of the pcore
+	 * with the other run queues of the pcore, tasks on one core
+	 * interfere regardless of their run queue.
+	 *
+	 * \param on_demand  the run queue is created for a task and is
+	 *                   destroyed with its last task, the default
+	 *                   and configured run queues are kept
+	 *
+	 * \return index of the run queue, also if it already existed,
+	 *         -1 if there is no such pcore
+	 */
+	int Sched_controller::create_runqueue(int pcore, Rq_task::Task_class task_class, Rq_task::Task_strategy task_strategy, bool on_demand)
+	{
+		if (pcore < 0 || pcore >= _num_pcores) {
+			PWRN("Sched_controller: there is no pcore %d for a run queue", pcore);
+			return -1;
 		}
 
-		return 0;
+		int key = _rq_key(pcore, task_class, task_strategy);
+		if (_rq_index[key] >= 0) {
+			return _rq_index[key];
+		}
+
+		int index;
+		if (_free_runqueues.empty()) {
+			index = _runqueue.size();
+			_runqueue.push_back(Runqueue());
+		} else {
+			index = _free_runqueues.back();
+			_free_runqueues.pop_back();
+		}
+		_runqueue[index] = { task_class, task_strategy, pcore, 0, on_demand };
+		_rq_index[key] = index;
+		_rqs_of_kind[_kind(task_class, task_strategy)].push_back(index);
+		_rqs_on_pcore[pcore]++;
+		SCHED_INF("Created run queue %d on pcore %d", index, pcore);
+		return index;
+	}
+
+	/**
+	 * Destroy a run queue that holds no tasks, e.g. after its
+	 * last task has departed
+	 *
+	 * \return true if the run queue was destroyed
+	 */
+	bool Sched_controller::destroy_runqueue(int index)
+	{
+		if (index < 0 || index >= (int)_runqueue.size() || _runqueue[index].rq_buffer < 0 || _runqueue[index].num_tasks > 0) {
+			return false;
+		}
+
+		Runqueue &rq = _runqueue[index];
+		std::vector<int> &kind = _rqs_of_kind[_kind(rq._task_class, rq._task_strategy)];
+		kind.erase(std::find(kind.begin(), kind.end(), index));
+		_rq_index[_rq_key(rq.rq_buffer, rq._task_class, rq._task_strategy)] = -1;
+		_rqs_on_pcore[rq.rq_buffer]--;
+		SCHED_INF("Destroyed run queue %d on pcore %d", index, rq.rq_buffer);
+		rq.rq_buffer = -1;
+		_free_runqueues.push_back(index);
+		return true;
 	}
 
 	/**
@@ -226,20 +1086,79 @@ namespace Sched_controller {
 	 * pcore/rq_buffer.
 	 *
 	 * \param newly arriving task
+	 *
+	 * \return  0 if the task was enqueued
+	 *         <0 in any other case
 	 */
-	void Sched_controller::allocate_task(Rq_task::Rq_task task)
+	int Sched_controller::allocate_task(Rq_task::Rq_task task)
 	{
 
-		PINF("Start allocating Task with id %d", task.task_id);
-		Task_allocator::allocate_task(this, &task);
+		SCHED_INF("Start allocating Task with id %d", task.task_id);
+		return Task_allocator::allocate_task(this, &task);
 
 	}
 
-	void Sched_controller::task_to_rq(int rq, Rq_task::Rq_task *task) {
+	int Sched_controller::task_to_rq(int rq, Rq_task::Rq_task *task) {
 		//PINF("Number of RQs: %d", _rq_manager.get_num_rqs());
-		int status = enq(rq, *task);
-		//PDBG("%d", status);
-		return;
+		return enq(rq, *task);
+	}
+
+	/**
+	 * Evaluate the admission test of _admit and the headroom of
+	 * task on every core of verdicts. The tests run on the pool
+	 * against snapshots of the run queues, enq repeats the test on
+	 * the live run queue of the chosen core. With Audsley's priority
+	 * assignment, a hi task that fails the test with its priority is
+	 * tried with reassigned priorities, as _admit does. The headroom
+	 * only ranks several admissible cores and comes from the cache
+	 * of _sensitivity, which is dropped when a run queue changes.
+	 * A lo task without a test is placed where its estimated wcet
+	 * fits into the headroom of _rq_estimate, if the estimation is
+	 * on.
+	 */
+	void Sched_controller::evaluate_cores(Rq_task::Rq_task *task, std::vector<Admission_pool::Verdict> *verdicts)
+	{
+		Rq_task::Rq_task effective = _effective(*task);
+		Admission_pool::Test test = _test_of(*task);
+
+		/* the pool rejects cores that are not one of ours */
+		for (auto &verdict : *verdicts) {
+			if (verdict.core >= 0 && verdict.core < _num_cores) {
+				_pool->snapshot(verdict.core, &_rq_view[verdict.core], &_rq_util[verdict.core]);
+			}
+		}
+		_pool->evaluate(*task, test, verdicts);
+
+		int num_admissible = 0;
+		std::vector<Rq_task::Rq_task> order;
+		for (auto &verdict : *verdicts) {
+			if (verdict.core < 0 || verdict.core >= _num_cores) {
+				continue;
+			}
+			if (!verdict.admissible && test == Admission_pool::Test::fp && _admission_mode == Admission_mode::audsley) {
+				std::vector<Rq_task::Rq_task> rq_tasks;
+				_tasks_of(verdict.core, &rq_tasks);
+				fp_alg.core(verdict.core);
+				verdict.admissible = fp_alg.audsley(task, &rq_tasks, &order);
+			}
+			if (verdict.admissible) {
+				num_admissible++;
+			}
+		}
+
+		for (auto &verdict : *verdicts) {
+			if (verdict.core < 0 || verdict.core >= _num_cores) {
+				continue;
+			}
+			if (test == Admission_pool::Test::none && _estimator) {
+				verdict.headroom = _estimate_sensitivity->headroom(verdict.core, &_rq_estimate[verdict.core], effective.inter_arrival);
+			} else if (test == Admission_pool::Test::none || (verdict.admissible && num_admissible > 1)) {
+				verdict.headroom = _sensitivity->headroom(verdict.core, &_rq_view[verdict.core], task->inter_arrival);
+			}
+			if (test == Admission_pool::Test::none) {
+				verdict.admissible = verdict.headroom >= effective.wcet;
+			}
+		}
 	}
 
 
@@ -267,7 +1186,7 @@ namespace Sched_controller {
 	 */
 	int Sched_controller::get_num_rqs()
 	{
-		return _num_rqs;
+		return _runqueue.size() - _free_runqueues.size();
 	}
 
 	int Sched_controller::get_num_cores()
@@ -284,13 +1203,10 @@ namespace Sched_controller {
 	 */
 	void Sched_controller::which_runqueues(std::vector<Runqueue> *rq, Rq_task::Task_class task_class, Rq_task::Task_strategy task_strategy)
 	{
-		rq->reserve(_num_rqs);
-		for (int i = 0; i < _num_rqs; i++) {
-			if (_runqueue[i]._task_class == task_class) {
-				if (_runqueue[i]._task_strategy == task_strategy) {
-					rq->push_back(_runqueue[i]);
-				}
-			}
+		std::vector<int> const &kind = _rqs_of_kind[_kind(task_class, task_strategy)];
+		rq->reserve(rq->size() + kind.size());
+		for (int index : kind) {
+			rq->push_back(_runqueue[index]);
 		}
 
 		return;
@@ -335,6 +1251,107 @@ namespace Sched_controller {
 		}
 	}
 
+	/**
+	 * Largest wcet of a new task with the given period and
+	 * an implicit deadline that still fits into the run queue
+	 * of core at the lowest priority. Cached until the run
+	 * queue changes.
+	 */
+	unsigned long long Sched_controller::get_headroom(int core, unsigned long long period)
+	{
+		if (core < 0 || core >= _num_cores) {
+			return 0;
+		}
+		return _sensitivity->headroom(core, &_rq_view[core], period);
+	}
+
+	/**
+	 * Largest amount the wcet of an admitted task may grow
+	 * while its run queue stays schedulable.
+	 *
+	 * \return slack, or -1 if the task is in no run queue
+	 */
+	long long Sched_controller::get_wcet_slack(std::string task_name)
+	{
+		for (int i = 0; i < _num_cores; i++) {
+			long long slack = _sensitivity->wcet_slack(i, &_rq_view[i], task_name);
+			if (slack >= 0) {
+				return slack;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Get the recording of the optimizer inputs
+	 *
+	 * \return dataspace of the recording, invalid if nothing is recorded
+	 */
+	Genode::Dataspace_capability Sched_controller::get_opt_trace()
+	{
+		if (!_opt_recorder) {
+			return Genode::Dataspace_capability();
+		}
+		return _opt_recorder->dataspace();
+	}
+
+	/**
+	 * Print the recording of the optimizer inputs to the LOG
+	 */
+	void Sched_controller::dump_opt_trace()
+	{
+		if (!_opt_recorder) {
+			PWRN("Sched_controller: the optimizer inputs are not recorded, set the opt_trace size in the config");
+			return;
+		}
+		_opt_recorder->dump();
+	}
+
+	/**
+	 * Get the event rings of the controller
+	 *
+	 * \return dataspace of the rings, invalid if tracing is off
+	 */
+	Genode::Dataspace_capability Sched_controller::get_trace()
+	{
+		if (!Sched_trace::tracer()) {
+			return Genode::Dataspace_capability();
+		}
+		return Sched_trace::tracer()->dataspace();
+	}
+
+	/**
+	 * Get a copy of the statistics page of the controller, refreshed
+	 * on every call
+	 */
+	Genode::Dataspace_capability Sched_controller::get_stats_ds()
+	{
+		return _stats->publish();
+	}
+
+	/**
+	 * Get a copy of the statistics of a core
+	 *
+	 * \return counters of the core, all zero but num_cores for an invalid core
+	 */
+	Sched_stats::Core_stats Sched_controller::get_stats(int core)
+	{
+		return _stats->snapshot(core);
+	}
+
+	/**
+	 * Count a failed enqueue of a run queue
+	 *
+	 * \param error  return value of Rq_buffer::enq()
+	 */
+	void Sched_controller::_count_rq_error(int core, int error)
+	{
+		if (error == 2)
+			SCHED_STAT_INC(core, rq_locked);
+		else
+			SCHED_STAT_INC(core, rq_full);
+	}
+
 	/**
 	 * Get a list of pcores that are assigned no runqueues
 	 *
@@ -352,12 +1369,10 @@ namespace Sched_controller {
 		std::forward_list<Pcore*> unused_pcores;
 
 		for (auto it = pcores.begin(); it != pcores.end(); it++) {
-			/* 
-			 * has the pcore any runqueues associated? If it hasn't, it can not
-			 * be found in the _pcore_rq_association unordered_multimap
-			 */
-			if (_pcore_rq_association.find(*it) == _pcore_rq_association.end()) {
-				PDBG("Pcore has no RQ, it claims...");
+			/* has the pcore any runqueues associated? */
+			int id = (*it)->get_id();
+			if (id >= 0 && id < _num_pcores && _rqs_on_pcore[id] == 0) {
+				SCHED_DBG("Pcore has no RQ, it claims...");
 				unused_pcores.push_front(*it);
 			}
 		}
@@ -371,6 +1386,8 @@ namespace Sched_controller {
 
 	Sched_controller::Sched_controller()
 	{
+		_read_config();
+
 		/* We then need to figure out how many CPU cores are available at the system */
 		_set_num_pcores();
 
@@ -380,10 +1397,28 @@ namespace Sched_controller {
 		/* Now lets create the runqueues we're working with */
 		_init_runqueues();
 
-		_rqs = new Rq_buffer<Rq_task::Rq_task>[_num_cores];
+		_rqs = new Rq_buffer<Rq_task::Rq_entry>[_num_cores];
+		_rq_util = new Rq_util[_num_cores];
+		_rq_view = new Rq_view[_num_cores];
+		_rq_estimate = new Rq_view[_num_cores];
+		_slots.resize(_num_cores);
+		_mirror.resize(_num_cores);
+		for (int i = 0; i < _num_cores; i++) {
+			Sched_alg::reset_util(&_rq_util[i]);
+		}
+		_sensitivity = new Sched_sensitivity(_num_cores);
+		if (_allocation_workers < 0) {
+			_allocation_workers = _num_cores;
+		}
+		_pool = new Admission_pool(_num_cores, _allocation_workers);
+		PINF("Allocation evaluates the cores %s (%d workers)", _allocation_workers ? "in parallel" : "sequentially", _allocation_workers);
+		if (_provisional_admission) {
+			_background = new Background_admission();
+			_background->start();
+		}
 
 		mon_ds_cap = Genode::env()->ram_session()->alloc(100*sizeof(Mon_manager::Monitoring_object));
-		Mon_manager::Monitoring_object *threads = Genode::env()->rm_session()->attach(mon_ds_cap);
+		_mon_threads = Genode::env()->rm_session()->attach(mon_ds_cap);
 
 		rq_ds_cap = Genode::env()->ram_session()->alloc(101*sizeof(int));
 		rqs=Genode::env()->rm_session()->attach(rq_ds_cap);
@@ -391,7 +1426,7 @@ namespace Sched_controller {
 		sync_ds_cap = Genode::env()->ram_session()->alloc(100*sizeof(int));
 		_rqs[0].init_w_shared_ds(sync_ds_cap);
 		
-		dead_ds_cap = Genode::env()->ram_session()->alloc(256*sizeof(long long unsigned));
+		dead_ds_cap = Genode::env()->ram_session()->alloc(Opt_trace::RIP_SIZE*sizeof(long long unsigned));
 
 
 
@@ -408,21 +1443,28 @@ namespace Sched_controller {
 
 		//_init_rqs(_num_rqs);
 
-		/*
-		 * After we know about our run queues, we will assign them to the pcores.
-		 * Currently we have 4 run queues and 4 pcores. Hence we can make a fixed
-		 * assignement.
-		 *
-		 * ATTENTION: This implementation is only for testing until run queues can
-		 *            be created dynamically!
-		 */
-		for (int i = 0; i < _num_rqs; i++) {
-			std::pair<Pcore*, Runqueue*> _pcore_rq_pair (_pcore + i, _runqueue + i);
-			_pcore_rq_association.insert(_pcore_rq_pair);
-			//PINF("Allocated rq_buffer %d to _pcore %d", i, i);
+		_optimizer = new Sched_opt(_num_cores, &_mon_manager, _mon_threads, mon_ds_cap, dead_ds_cap);
+		if (_opt_trace_size > 0)
+		{
+			_opt_recorder = new Opt_recorder(_opt_trace_size, _num_cores);
+			_optimizer->record(_opt_recorder);
+			PINF("Recording the optimizer inputs (%lu bytes)", (unsigned long)_opt_trace_size);
+		}
+		_optimizer->on_departure(this);
+		if (_wcet_estimation)
+		{
+			_estimator = new Wcet_estimator(_wcet_config);
+			_estimate_sensitivity = new Sched_sensitivity(_num_cores);
+			_optimizer->estimate(_estimator);
+			PINF("Estimating the wcet of lo tasks, %u per mille quantile, %u%% margin", _wcet_config.quantile, _wcet_config.margin);
+		}
+		_stats = new Sched_stats::Stats(_num_cores);
+		Sched_stats::stats() = _stats;
+		if (_trace_size > 0)
+		{
+			Sched_trace::tracer() = new Sched_trace::Tracer(_trace_size, _num_cores);
+			PINF("Tracing the controller (%lu bytes)", (unsigned long)_trace_size);
 		}
-
-		_optimizer = new Sched_opt(_num_cores, &_mon_manager, threads, mon_ds_cap, dead_ds_cap);
 				
 		//loop forever
 		//the_cycle();
@@ -433,42 +1475,221 @@ namespace Sched_controller {
 
 	}
 
+	/**
+	 * Task as it is deployed on a core: a split task with the
+	 * portion of the core, any other with its admitted parameters.
+	 * Both keep the priority they were admitted with, which
+	 * Audsley's assignment may have changed, see _rewrite_rq.
+	 *
+	 * \return false if the controller does not know the thread
+	 */
+	bool Sched_controller::_deployed_task(int core, std::string const &name, Rq_task::Rq_task *task)
+	{
+		auto split = _split.find(name);
+		if (split != _split.end() && (split->second.head_core == core || split->second.tail_core == core))
+		{
+			int task_id = task->task_id;
+			*task = (split->second.head_core == core) ? split->second.head : split->second.tail;
+			task->task_id = task_id;
+			return true;
+		}
+
+		auto it = task_map.find(name);
+		if (it == task_map.end())
+		{
+			return false;
+		}
+		task->task_class = it->second.task_class;
+		task->wcet = it->second.wcet;
+		task->wcet_hi = it->second.wcet_hi;
+		task->inter_arrival = it->second.inter_arrival;
+		task->jitter = it->second.jitter;
+		task->blocking = it->second.blocking;
+		task->deadline = it->second.deadline;
+		task->prio = it->second.prio;
+		strcpy(task->name, it->second.name);
+		return true;
+	}
+
+	/**
+	 * Mirror the run queue of the kernel in the Rq_buffer of a core.
+	 * The kernel list carries no generation, so the list of the last
+	 * update serves as one: only threads that left, arrived or changed
+	 * their priority since then are dequeued or enqueued, as well as
+	 * the tasks admitted meanwhile, whose threads are all evaluated
+	 * again. A task is enqueued once while any of its jobs is
+	 * deployed, only the threads of known tasks are counted as jobs.
+	 * The monitoring data is only read to name new threads. A run
+	 * queue that was rewritten is rebuilt completely, with the
+	 * priorities of the rewrite.
+	 */
 	int Sched_controller::update_rq_buffer(int core)
 	{
-		PINF("Update Rq_buffer for core %d!", core);
-		_rqs[core].init_w_shared_ds(sync_ds_cap_vector.at(core));
-		Mon_manager::Monitoring_object *threads = Genode::env()->rm_session()->attach(mon_ds_cap);
+		if (core < 0 || core >= _num_cores)
+		{
+			return -1;
+		}
+
+		SCHED_INF("Update Rq_buffer for core %d!", core);
+		SCHED_TRACE(DEPLOY_BEGIN, core, 0, nullptr, core, 0);
+		SCHED_STAT_INC(core, deploys);
+		Rq_mirror &mirror = _mirror[core];
+
 		rqs[1]=1;
 		rqs[2]=1;
 		_mon_manager.update_rqs(rq_ds_cap);
-		_mon_manager.update_info(mon_ds_cap);
 
-		std::unordered_map<std::string, Rq_task::Rq_task>::iterator it;
-		for(int i=1; i<= rqs[0]; ++i){
-			Rq_task::Rq_task task;
-			task.task_id = rqs[2*i-1];
-			task.prio = rqs[2*i];
-			for(int j=0; j<100; ++j)
+		std::vector<std::pair<int, int>> list; /* foc_id, prio */
+		list.reserve(rqs[0]);
+		for (int i = 1; i <= rqs[0]; ++i)
+		{
+			list.push_back({ rqs[2*i-1], rqs[2*i] });
+		}
+
+		if (mirror.synced && mirror.pending.empty() && list == mirror.list)
+		{
+			SCHED_TRACE(DEPLOY_END, core, 0, nullptr, core, _rqs[core].get_num_elements());
+			return 0;
+		}
+
+		bool rebuilt = !mirror.synced;
+		if (rebuilt)
+		{
+			int success = _rqs[core].clear();
+			if (success != 0)
+			{
+				_count_rq_error(core, success);
+				return success;
+			}
+			_clear_slots(core);
+			_reset_analysis(core);
+			mirror.list.clear();
+			mirror.names.clear();
+			mirror.jobs.clear();
+			mirror.counted.clear();
+			mirror.pending.clear();
+			mirror.synced = true;
+		}
+
+		/* admitted tasks stay in the run queue only if the kernel runs them */
+		std::unordered_set<std::string> admitted;
+		admitted.swap(mirror.pending);
+		for (auto &name : admitted)
+		{
+			_dequeue(core, name);
+			if (mirror.jobs.count(name))
+			{
+				/* the task was deployed before, its older entry lost its position */
+				_index_slots(core);
+			}
+		}
+
+		std::unordered_map<int, int> deployed; /* foc_id -> prio of the current list */
+		deployed.reserve(list.size());
+		for (auto &entry : list)
+		{
+			deployed[entry.first] = entry.second;
+		}
+
+		std::unordered_map<int, int> previous; /* foc_id -> prio of the last update */
+		previous.reserve(mirror.list.size());
+		for (auto &entry : mirror.list)
+		{
+			previous[entry.first] = entry.second;
+			auto now = deployed.find(entry.first);
+			if (now == deployed.end() || now->second != entry.second)
 			{
-				if(threads[j].foc_id == task.task_id)
+				auto name = mirror.names.find(entry.first);
+				if (name != mirror.names.end())
 				{
-					it = task_map.find(threads[j].thread_name.string());
-					if (it != task_map.end())
+					auto jobs = mirror.jobs.find(name->second);
+					if (mirror.counted.erase(entry.first) && jobs != mirror.jobs.end() && --jobs->second == 0)
+					{
+						_dequeue(core, name->second);
+						mirror.jobs.erase(jobs);
+					}
+					if (now == deployed.end())
 					{
-						task.wcet = it->second.wcet;
-						task.inter_arrival = it->second.inter_arrival;
-						task.deadline = it->second.deadline;
-						strcpy(task.name, it->second.name);
-						_rqs[core].enq(task);
+						mirror.names.erase(name);
 					}
-					break;
 				}
-				if(threads[j].foc_id == 0 && threads[j].prio == 0)
+			}
+		}
+
+		std::unordered_map<int, int> thread_of; /* foc_id -> index in _mon_threads */
+		bool monitored = false;                 /* the monitoring data is only read to name new threads */
+		for (auto &entry : list)
+		{
+			auto known = mirror.names.find(entry.first);
+			auto before = previous.find(entry.first);
+			if (before != previous.end() && before->second == entry.second)
+			{
+				/* a thread of a task that was unknown is counted once the task is admitted */
+				if (mirror.counted.count(entry.first) || known == mirror.names.end() || !admitted.count(known->second))
+				{
+					continue;
+				}
+			}
+
+			if (known == mirror.names.end())
+			{
+				if (!monitored)
+				{
+					_mon_manager.update_info(mon_ds_cap);
+					for (int j = 0; j < 100; ++j)
+					{
+						if (_mon_threads[j].foc_id == 0 && _mon_threads[j].prio == 0)
+						{
+							break;
+						}
+						thread_of.insert({ (int)_mon_threads[j].foc_id, j });
+					}
+					monitored = true;
+				}
+
+				auto thread = thread_of.find(entry.first);
+				if (thread == thread_of.end())
 				{
-					break;
+					continue;
 				}
+				known = mirror.names.insert({ entry.first, _mon_threads[thread->second].thread_name.string() }).first;
 			}
+			std::string const &name = known->second;
+
+			Rq_task::Rq_task task;
+			task.task_id = entry.first;
+			task.prio = entry.second;
+			if (!_deployed_task(core, name, &task))
+			{
+				continue;
+			}
+
+			/* the jobs of a task are threads of their own, the task is enqueued once */
+			mirror.counted.insert(entry.first);
+			if (mirror.jobs[name]++ > 0)
+			{
+				continue;
+			}
+
+			bool rate_monotonic = _rq_util[core].rate_monotonic && fp_alg.rate_monotonic(&task, &_rq_view[core]);
+			int success = _enq(core, task);
+			if (success == 0)
+			{
+				_account(core, task, rate_monotonic);
+				_invalidate(core);
+			}
+			else
+			{
+				_count_rq_error(core, success);
+			}
+		}
+
+		mirror.list.swap(list);
+		if (rebuilt)
+		{
+			_check_committed_order(core);
 		}
+		SCHED_TRACE(DEPLOY_END, core, 0, nullptr, core, _rqs[core].get_num_elements());
 		return 0;
 	}
 
@@ -509,7 +1730,9 @@ namespace Sched_controller {
 		//store number of tuples at first position of array
 		list[0]=counter-1;
 		list[1]=1;
+		SCHED_TRACE(DEPLOY_BEGIN, 0, 0, nullptr, 0, 0);
 		sync.deploy(_ds, 0, 0);
+		SCHED_TRACE(DEPLOY_END, 0, 0, nullptr, 0, counter - 1);
 		Genode::env()->ram_session()->free(_ds);
 		the_cycle();
 	}
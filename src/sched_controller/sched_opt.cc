@@ -13,8 +13,13 @@
 /* ******************************** */
 
 #include "sched_controller/sched_opt.h"
+#include "sched_controller/log.h"
+#include "sched_controller/stats.h"
+#include "sched_controller/trace.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <string>
 #include <cstring>
 
@@ -34,6 +39,10 @@ namespace Sched_controller {
 		// Definition of the optimization goal via xml file
 		Genode::Rm_session* rm = Genode::env()->rm_session();
 		const char* xml = rm->attach(xml_ds_cap);
+		if (_recorder)
+		{
+			_recorder->goal(xml);
+		}
 		Genode::Xml_node root(xml);
 
 		const auto fn = [this] (const Genode::Xml_node& node)
@@ -74,15 +83,19 @@ namespace Sched_controller {
 		
 		rm->detach(xml);
 		
-		PINF("Optimizer (set_goal): New optimization goal is %s, with query_interval %d", (_opt_goal==FAIRNESS)? "fairness": (_opt_goal==UTILIZATION)? "utilization": "none", query_intervall);
+		SCHED_INF("Optimizer (set_goal): New optimization goal is %s, with query_interval %d", (_opt_goal==FAIRNESS)? "fairness": (_opt_goal==UTILIZATION)? "utilization": "none", query_intervall);
 	}
 	
 	
 	void Sched_opt::add_task(unsigned int core, Rq_task::Rq_task task)
 	{
+		if (_recorder)
+		{
+			_recorder->add_task(core, task);
+		}
 		
-		unsigned int values [num_cores];
-		// for all cores the value is initially 0
+		// the values outlive this call, for all cores the value is initially 0
+		unsigned int *values = new unsigned int[num_cores];
 		for (int i=0; i < num_cores; ++i)
 		{
 			values[i] = 0;
@@ -103,12 +116,17 @@ namespace Sched_controller {
 		_task.newest_job.foc_id = 0;
 		_task.newest_job.arrival_time = 0;
 		_task.newest_job.dispatched = true;
+		_task.next_check = ~0ULL;
 		
 		// used to do utilization optimisation
 		_task.utilization = 1;
 		_task.value = values;
 		
-		_tasks.insert({_task.name, _task});
+		if (!_tasks.insert({_task.name, _task}).second)
+		{
+			// the task is already known, keep its values
+			delete[] values;
+		}
 		//PDBG("Optimizer (add_task): Add task %s to task list (core: %u).", std::string(task.name).c_str(), core);
 		//PDBG("Optimizer (add_task): New task %s has deadline %llu.", std::string(task.name).c_str(), task.deadline);
 		
@@ -116,6 +134,10 @@ namespace Sched_controller {
 	void Sched_opt::last_job_started(std::string task_name)
 	{
 		// This function is called by the taskloader as soon as the last job was started for this task.
+		if (_recorder)
+		{
+			_recorder->call(Opt_trace::LAST_JOB_STARTED, task_name);
+		}
 		
 		if(_tasks.count(task_name))
 		{
@@ -125,51 +147,149 @@ namespace Sched_controller {
 		else
 		{
 			// the task was not found in task list
-			PWRN("Optimizer (last_job_started): The requested task %s was not in task list any more.", task_name.c_str());
+			SCHED_WRN("Optimizer (last_job_started): The requested task %s was not in task list any more.", task_name.c_str());
 		}
 	}
 	
 	void Sched_opt::start_optimizing(std::string task_name)
 	{
-		// This function determines if any thask has a job which reached its time to have a deadline
-		//PDBG("Optimizer (start_optimizing): start optimizing task %s.", task_name.c_str());
+		// This function registers the next check point of the task, i.e. the deadline of its current job,
+		// and processes all check points that have passed. The task is checked at once if it has not started yet.
 		
-		std::unordered_map<std::string, Optimization_task>::iterator it = _tasks.find(task_name);
-		if(it == _tasks.end())
+		if (_recorder)
 		{
-			return;
+			_recorder->call(Opt_trace::START_OPTIMIZING, task_name);
 		}
-		bool monitor_queried = false;
-		int count = 0;
-		unsigned long current_time = 0;
-		unsigned long long real_deadline = it->second.arrival_time + it->second.deadline;
-		while (!monitor_queried)
+		
+		if(_tasks.count(task_name))
 		{
-			current_time = timer.elapsed_ms();
-			
-			// if it's time to see what happend, ...
-			if (current_time >= real_deadline || (it->second.arrival_time == 0))
+			_schedule_check(task_name);
+			_process_due();
+		}
+		
+		if (_recorder)
+		{
+			_recorder->digest(state_digest());
+		}
+	}
+	
+	void Sched_opt::check_due()
+	{
+		if (_recorder)
+		{
+			_recorder->call(Opt_trace::CHECK_DUE, std::string());
+		}
+		
+		// the timeout has expired, it is programmed again even if the next check point is the same
+		_programmed = ~0ULL;
+		_process_due();
+		
+		if (_recorder)
+		{
+			_recorder->digest(state_digest());
+		}
+	}
+	
+	unsigned long long Sched_opt::next_check()
+	{
+		// drop stale entries on top, e.g. of removed tasks
+		while (!_checks.empty())
+		{
+			std::unordered_map<std::string, Optimization_task>::iterator it = _tasks.find(_checks.front().task);
+			if (it != _tasks.end() && it->second.next_check == _checks.front().due)
 			{
-				//... query monitor-info about current task (was there any deadline miss?)
-				//PDBG("Optimizer (start_optimizing):  Do optimization due to task %s at iteration %d", task_name.c_str(), count);
-				_query_monitor(it->first, current_time);
-				monitor_queried = true;
+				return _checks.front().due;
 			}
-			
-			//PDBG("Optimizer: - %d, act_time = %lu", count, current_time);
-			//PDBG("Optimizer: - %d, deadline = %llu, arrival: %llu, deadl: %llu", count, real_deadline, it->second.arrival_time, it->second.deadline);
-			
-			// wait some time to query the next monitor data
-			timer.msleep(query_intervall);
-			++count;
+			std::pop_heap(_checks.begin(), _checks.end(), std::greater<Check>());
+			_checks.pop_back();
 		}
-		//PDBG("Optimizer (start_optimizing): Finish optimizing task %s.", task_name.c_str());
-		
+		return ~0ULL;
+	}
+	
+	void Sched_opt::on_timeout(Check_timeout *timeout)
+	{
+		_timeout = timeout;
+		_programmed = ~0ULL;
+		_program_timeout();
 	}
 	
 	
 	// public getter
 	int Sched_opt::scheduling_allowed(std::string task_name)
+	{
+		int allowed = _scheduling_allowed(task_name);
+		if (_recorder)
+		{
+			_recorder->scheduling_allowed(task_name, allowed);
+		}
+		return allowed;
+	}
+	
+	void Sched_opt::record(Opt_recorder *recorder)
+	{
+		_recorder = recorder;
+	}
+	
+	void Sched_opt::estimate(Wcet_estimator *estimator)
+	{
+		_estimator = estimator;
+	}
+	
+	void Sched_opt::on_departure(Departure_handler *handler)
+	{
+		_departure = handler;
+	}
+	
+	void Sched_opt::remove_task(std::string task_name)
+	{
+		if (_recorder)
+		{
+			_recorder->call(Opt_trace::REMOVE_TASK, task_name);
+		}
+		
+		if(_tasks.count(task_name))
+		{
+			_remove_task(task_name, _tasks.at(task_name).newest_job.foc_id, KILLED, false);
+		}
+	}
+	
+	unsigned long long Sched_opt::state_digest()
+	{
+		// FNV-1a over the tasks, sorted by name
+		std::vector<const Optimization_task*> tasks;
+		for (auto &task : _tasks)
+		{
+			tasks.push_back(&task.second);
+		}
+		std::sort(tasks.begin(), tasks.end(), [] (const Optimization_task *a, const Optimization_task *b) {
+			return a->name < b->name;
+		});
+		
+		unsigned long long hash = 14695981039346656037ULL;
+		auto mix = [&hash] (const void *data, size_t len) {
+			for (size_t i = 0; i < len; ++i)
+			{
+				hash = (hash ^ ((const unsigned char *)data)[i]) * 1099511628211ULL;
+			}
+		};
+		for (auto task : tasks)
+		{
+			unsigned long long fields[] = { task->core, task->arrival_time, task->to_schedule,
+			                                task->last_job_started, task->id_related, task->newest_job.foc_id };
+			mix(task->name.c_str(), task->name.size() + 1);
+			mix(fields, sizeof(fields));
+			for (int i=0; i < num_cores; ++i)
+			{
+				unsigned long long value = task->value[i];
+				mix(&value, sizeof(value));
+			}
+		}
+		unsigned long long ended = _ended_tasks.size();
+		mix(&ended, sizeof(ended));
+		return hash;
+	}
+	
+	int Sched_opt::_scheduling_allowed(std::string task_name)
 	{
 		// This function looks up the to_schedule value of the requested task.
 		// It should be called by Taskloader before starting a task (some where in _session_component::start()).
@@ -190,10 +310,10 @@ namespace Sched_controller {
 		{
 			
 			// the requested task is in list of ended tasks
-			PINF("Optimizer (scheduling_allowed): Task %s has already ended (cause: %s).", task_name.c_str(), (it_end->second.cause_of_death==FINISHED)? "finished" : "killed");
+			SCHED_INF("Optimizer (scheduling_allowed): Task %s has already ended (cause: %s).", task_name.c_str(), (it_end->second.cause_of_death==FINISHED)? "finished" : "killed");
 			
 		}
-		PINF("Optimizer (scheduling_allowed): Task %s was not found in task lisk of actual or ended tasks.", task_name.c_str());
+		SCHED_INF("Optimizer (scheduling_allowed): Task %s was not found in task lisk of actual or ended tasks.", task_name.c_str());
 		return -1;
 	}
 	
@@ -217,6 +337,12 @@ namespace Sched_controller {
 		
 		// number of ms to sleep between two intervalls to query the monitor data
 		query_intervall = 100;
+		
+		_recorder = nullptr;
+		_estimator = nullptr;
+		_departure = nullptr;
+		_timeout = nullptr;
+		_programmed = ~0ULL;
 	}
 	
 	
@@ -232,6 +358,113 @@ namespace Sched_controller {
 	*/
 	
 	
+	unsigned long long Sched_opt::_elapsed_ms()
+	{
+		unsigned long long now = timer.elapsed_ms();
+		if (_recorder)
+		{
+			_recorder->time(now);
+		}
+		return now;
+	}
+	
+	
+	void Sched_opt::_update_info()
+	{
+		_mon_manager->update_info(_mon_ds_cap);
+		if (_recorder)
+		{
+			_recorder->monitor(_threads, 100);
+		}
+	}
+	
+	
+	void Sched_opt::_update_dead()
+	{
+		_mon_manager->update_dead(_dead_ds_cap);
+		if (_recorder)
+		{
+			_recorder->rip(rip);
+		}
+	}
+	
+	
+	void Sched_opt::_schedule_check(std::string task_str)
+	{
+		// the next check point is the deadline of the current job, a task that has not started yet is due at once
+		Optimization_task &task = _tasks.at(task_str);
+		unsigned long long due = (task.arrival_time == 0) ? 0 : task.arrival_time + task.deadline;
+		if (task.next_check == due)
+		{
+			return;
+		}
+		
+		// an older entry of the task becomes stale, it is dropped when it reaches the top
+		task.next_check = due;
+		_checks.push_back({ due, task_str });
+		std::push_heap(_checks.begin(), _checks.end(), std::greater<Check>());
+	}
+	
+	void Sched_opt::_process_due()
+	{
+		unsigned long long current_time = _elapsed_ms();
+		
+		// collect all tasks whose check point has passed
+		std::vector<std::string> due_tasks;
+		while (next_check() <= current_time)
+		{
+			_tasks.at(_checks.front().task).next_check = ~0ULL;
+			due_tasks.push_back(_checks.front().task);
+			std::pop_heap(_checks.begin(), _checks.end(), std::greater<Check>());
+			_checks.pop_back();
+		}
+		
+		if (!due_tasks.empty())
+		{
+			// fill _threads with data, once for all due tasks
+			_update_info();
+			
+			for (std::string const &task_str : due_tasks)
+			{
+				// a task may have been removed while analysing an earlier one
+				if (!_tasks.count(task_str))
+				{
+					continue;
+				}
+				
+				//... query monitor-info about current task (was there any deadline miss?)
+				_query_monitor(task_str, current_time);
+				
+				// a started task is checked again at the deadline of its next job
+				if (_tasks.count(task_str) && _tasks.at(task_str).arrival_time > 0
+				    && _tasks.at(task_str).arrival_time + _tasks.at(task_str).deadline > current_time)
+				{
+					_schedule_check(task_str);
+				}
+			}
+		}
+		
+		_program_timeout();
+	}
+	
+	void Sched_opt::_program_timeout()
+	{
+		if (!_timeout)
+		{
+			return;
+		}
+		
+		unsigned long long due = next_check();
+		if (due != _programmed)
+		{
+			_programmed = due;
+			
+			// the timeout has a clock of its own, it gets the delay in this one
+			unsigned long long now = timer.elapsed_ms();
+			_timeout->program((due == ~0ULL) ? ~0ULL : (due > now) ? due - now : 0);
+		}
+	}
+	
 	void Sched_opt::_query_monitor(std::string task_str, unsigned long long current_time)
 	{
 		// This function query monitoring information and analyzes it. Then it reacts correspondingly by adjusting the value, reacting on deadline misses and setting the to_schedule flags.
@@ -250,11 +483,10 @@ namespace Sched_controller {
 		
 		std::vector<unsigned int> new_threads_nr;
 		
-		// fill _threads with data
-		_mon_manager->update_info(_mon_ds_cap);
+		// _threads was filled by the caller, all tasks due at the same time share one snapshot
 		
 		// loop through _threads array
-		PINF("Optimizer (_query_monitor): Search in _threads for jobs of task %s", task_str.c_str());
+		SCHED_DBG("Optimizer (_query_monitor): Search in _threads for jobs of task %s", task_str.c_str());
 		for(int j=0; j<100; ++j)
 		{
 			// end of threads-array reached?
@@ -262,7 +494,7 @@ namespace Sched_controller {
 			{
 				break;
 			}
-			PINF("Optimizer (_query_monitor): thread %u: task %s, arrival %llu (curr: %llu), start %llu, c: %d", _threads[j].foc_id ,_threads[j].thread_name.string(), _threads[j].arrival_time, current_time, _threads[j].start_time, _threads[j].affinity.xpos());
+			SCHED_DBG("Optimizer (_query_monitor): thread %u: task %s, arrival %llu (curr: %llu), start %llu, c: %d", _threads[j].foc_id ,_threads[j].thread_name.string(), _threads[j].arrival_time, current_time, _threads[j].start_time, _threads[j].affinity.xpos());
 			// determine unknown (new) jobs of given task
 			if( !task_str.compare(_threads[j].thread_name.string()))
 			{
@@ -271,7 +503,7 @@ namespace Sched_controller {
 				{
 					if(_threads[j].arrival_time < current_time)
 					{
-						PINF("Optimizer (_query_monitor): Task %s has a new job: foc_id = %u, arrival = %llu (current: %llu).", _threads[j].thread_name.string(), _threads[j].foc_id, _threads[j].arrival_time, current_time);
+						SCHED_DBG("Optimizer (_query_monitor): Task %s has a new job: foc_id = %u, arrival = %llu (current: %llu).", _threads[j].thread_name.string(), _threads[j].foc_id, _threads[j].arrival_time, current_time);
 						new_threads_nr.push_back(j);
 					}
 					
@@ -307,7 +539,7 @@ namespace Sched_controller {
 			case 0:
 			{
 				// there are no new tasks => job_executed remains false
-				PINF("Optimizer (_query_monitor): No new job for task %s was found at monitoring list.", task_str.c_str());
+				SCHED_DBG("Optimizer (_query_monitor): No new job for task %s was found at monitoring list.", task_str.c_str());
 				break;
 			}
 			case 1:
@@ -320,12 +552,12 @@ namespace Sched_controller {
 				if (deadline_time_reached) // the job has no time left to be executed
 				{
 					// determine if the job had a deadline miss or correct execution and set the to_schedules values
-					PINF("Optimizer (_query_monitor): Task %s - job %u was executed.", task_str.c_str(), _threads[new_threads_nr[0]].foc_id);
+					SCHED_DBG("Optimizer (_query_monitor): Task %s - job %u was executed.", task_str.c_str(), _threads[new_threads_nr[0]].foc_id);
 					_task_executed(task_str, new_threads_nr[0], true);
 				}
 				else // the job has still some time left for execution
 				{
-					PINF("Optimizer (_query_monitor): Task %s - job %u has time left (%llu).", task_str.c_str(), _threads[new_threads_nr[0]].foc_id, _threads[new_threads_nr[0]].arrival_time + _tasks.at(task_str).deadline);
+					SCHED_DBG("Optimizer (_query_monitor): Task %s - job %u has time left (%llu).", task_str.c_str(), _threads[new_threads_nr[0]].foc_id, _threads[new_threads_nr[0]].arrival_time + _tasks.at(task_str).deadline);
 					_set_newest_job(task_str, new_threads_nr[0]);
 				}
 				
@@ -352,7 +584,7 @@ namespace Sched_controller {
 				
 				if ( (most_recent_thread <0) || (second_recent_thread <0) )
 				{
-					PWRN("Optimizer (_query_monitor): Although there are at least two threads, the two recent threads weren't found in new_threads list.");
+					SCHED_WRN("Optimizer (_query_monitor): Although there are at least two threads, the two recent threads weren't found in new_threads list.");
 					// job_executed stays false
 					break;
 				}
@@ -371,7 +603,7 @@ namespace Sched_controller {
 						// the most recent thread has still some time left to finish its execution
 						//-> don't change values or update to_schedule but set this thread as newest job
 						
-						PINF("Optimizer (_query_monitor): Task %s - job %u is newest job - still running.", task_str.c_str(), _threads[i].foc_id);
+						SCHED_DBG("Optimizer (_query_monitor): Task %s - job %u is newest job - still running.", task_str.c_str(), _threads[i].foc_id);
 						_set_newest_job(task_str, i);
 						continue;
 					}
@@ -380,9 +612,9 @@ namespace Sched_controller {
 					bool consider_this_thread =( ((i == most_recent_thread) && recent_deadline_time_reached) || ((i == second_recent_thread) && !recent_deadline_time_reached) );
 					
 					if (consider_this_thread)
-						PINF("Optimizer (_query_monitor): Task %s - job %u is newest ended job.", task_str.c_str(), _threads[i].foc_id);
+						SCHED_DBG("Optimizer (_query_monitor): Task %s - job %u is newest ended job.", task_str.c_str(), _threads[i].foc_id);
 					else
-						PINF("Optimizer (_query_monitor): Task %s - job %u is older job.", task_str.c_str(), _threads[i].foc_id);
+						SCHED_DBG("Optimizer (_query_monitor): Task %s - job %u is older job.", task_str.c_str(), _threads[i].foc_id);
 					
 					_task_executed(task_str, i, consider_this_thread);
 				}
@@ -402,7 +634,7 @@ namespace Sched_controller {
 			if(_tasks.at(task_str).arrival_time > 0)
 			{
 				// ... determine why it's not in monitoring list
-				PINF("Optimizer (_query_monitor): Task %s has not executed a job.", task_str.c_str());
+				SCHED_DBG("Optimizer (_query_monitor): Task %s has not executed a job.", task_str.c_str());
 				_task_not_executed(task_str);
 			}
 			// else: the task did not start until now -> query again later...
@@ -424,7 +656,7 @@ namespace Sched_controller {
 		unsigned int thread_core = _threads[thread_nr].affinity.xpos();
 		if (_tasks.at(task_str).core != thread_core)
 		{
-			PWRN("Optimizer (_task_executed): The task %s has changed its core from core-%d to core-%d.", task_str.c_str(), _tasks.at(task_str).core, thread_core);
+			SCHED_WRN("Optimizer (_task_executed): The task %s has changed its core from core-%d to core-%d.", task_str.c_str(), _tasks.at(task_str).core, thread_core);
 			_tasks.at(task_str).core = thread_core;
 		}
 		unsigned int core = _tasks.at(task_str).core;
@@ -444,6 +676,12 @@ namespace Sched_controller {
 			// update utilization
 			double new_util = _threads[thread_nr].execution_time.value / _tasks.at(task_str).inter_arrival;
 			_tasks.at(task_str).utilization = new_util;
+			
+			// the execution time of a complete job is a sample for the wcet estimation
+			if (_estimator)
+			{
+				_estimator->add(task_str, _threads[thread_nr].execution_time.value);
+			}
 		}
 		else
 		{
@@ -465,7 +703,7 @@ namespace Sched_controller {
 			}
 			else
 			{
-				PWRN("Optimizer (_task_executed): Thread %d was dispatched, but it doesn't correspond to the newest_job (with foc_id %d). How can this be?", _threads[thread_nr].foc_id, _tasks.at(task_str).newest_job.foc_id);
+				SCHED_WRN("Optimizer (_task_executed): Thread %d was dispatched, but it doesn't correspond to the newest_job (with foc_id %d). How can this be?", _threads[thread_nr].foc_id, _tasks.at(task_str).newest_job.foc_id);
 			}
 			
 		}
@@ -511,7 +749,7 @@ namespace Sched_controller {
 					// The newest_job was not detected correctly
 					//	=> there is no other task (which could set the dispatched-value)
 					//	or the deadline of the other task is in between the deadline of this task and the actual start time of next thread of this task
-					PWRN("Optimizer (_task_not_executed): The newest_job was not detected correcly.");
+					SCHED_WRN("Optimizer (_task_not_executed): The newest_job was not detected correcly.");
 				
 					// thus the matching of foc_id and task wouldn't work for rip list
 				}
@@ -521,7 +759,7 @@ namespace Sched_controller {
 					bool task_in_rip = false;
 				
 					// fill rip list with data
-					_mon_manager->update_dead(_dead_ds_cap);
+					_update_dead();
 		
 					// rip is a 'list of tuples (foc_id, time)' similar to RQ list of Monitor
 					// RIP table size is shown in rip[0]
@@ -542,7 +780,7 @@ namespace Sched_controller {
 								// check for core change
 								if(_tasks.at(task_str).core != _tasks.at(task_str).newest_job.core)
 								{
-									PWRN("Optimizer (_task_not_executed): The task %s has changed its core from core-%d to core-%d.", task_str.c_str(), _tasks.at(task_str).core, _tasks.at(task_str).newest_job.core);
+									SCHED_WRN("Optimizer (_task_not_executed): The task %s has changed its core from core-%d to core-%d.", task_str.c_str(), _tasks.at(task_str).core, _tasks.at(task_str).newest_job.core);
 									_tasks.at(task_str).core = _tasks.at(task_str).newest_job.core;
 								}
 								
@@ -552,8 +790,9 @@ namespace Sched_controller {
 							}
 							else // the task was killed by the user
 							{
-								// remove it from the _tasks list
+								// remove it from the _tasks list, it must not be looked up any more
 								_remove_task(task_str, rip[i], KILLED);
+								return;
 							}
 						}
 					}
@@ -561,7 +800,7 @@ namespace Sched_controller {
 					if(!task_in_rip)
 					{
 						// the task was not in RIP list and also not in monitoring list
-						PWRN("The task %s was neither in monitoring nor in rip list.", task_str.c_str());
+						SCHED_WRN("The task %s was neither in monitoring nor in rip list.", task_str.c_str());
 					}
 				}
 			}
@@ -581,7 +820,7 @@ namespace Sched_controller {
 					// The newest_job was not detected correctly
 					//	=> there is no other task (which could set the dispatched-value)
 					//	or the deadline of the other task is in between the deadline of this task and the actual start time of next thread of this task
-					PWRN("Optimizer (_task_not_executed): The newest_job was not detected correcly.");
+					SCHED_WRN("Optimizer (_task_not_executed): The newest_job was not detected correcly.");
 				}
 				else
 				{
@@ -589,7 +828,7 @@ namespace Sched_controller {
 					// The deadline time for the newest job has reached, the job was allowed to run.
 					// The newest_job was already handled by the optimizer and no new thread was found in monitoring list.
 					// The last job of this task will still occur later so this is not the last job.
-					PWRN("Optimizer (_task_not_executed): The task should be executed but wasn't.");
+					SCHED_WRN("Optimizer (_task_not_executed): The task should be executed but wasn't.");
 				}
 			}
 		}
@@ -600,10 +839,18 @@ namespace Sched_controller {
 	{
 		// find causation task
 		std::string cause_task_str = _get_cause_task(task_str);
+		SCHED_STAT_INC(_tasks.at(task_str).core, deadline_misses);
+		SCHED_TRACE(DEADLINE_REACHED, _tasks.at(task_str).core, _tasks.at(task_str).newest_job.foc_id, task_str.c_str(), !cause_task_str.empty(), 0);
+
+		// the job needed at least its deadline, it is a censored sample for the wcet estimation
+		if (_estimator)
+		{
+			_estimator->add_censored(task_str);
+		}
 		if(cause_task_str.empty())
 		{
 			// The task reached its deadline an no task in monitoring list caused this ???
-			PWRN("Optimizer: The current job of task %s reached its deadline although there is no cause thread in monitoring data.", task_str.c_str());
+			SCHED_WRN("Optimizer: The current job of task %s reached its deadline although there is no cause thread in monitoring data.", task_str.c_str());
 			
 		}
 		else
@@ -619,7 +866,7 @@ namespace Sched_controller {
 			{
 				// This situation may happen if a task doesn't know about this task to be its cometitor
 				// and allowed a competitor of this task to be executed too 
-				PWRN("Optimizer: The Task %s is already in competitors list of task %s, but %s had a deadline miss because of it.", cause_task_str.c_str(), task_str.c_str(), task_str.c_str());
+				SCHED_WRN("Optimizer: The Task %s is already in competitors list of task %s, but %s had a deadline miss because of it.", cause_task_str.c_str(), task_str.c_str(), task_str.c_str());
 			}
 			else
 			{
@@ -637,7 +884,7 @@ namespace Sched_controller {
 				{
 					// Report error situation to the console
 					if (cause_already_at_competitors || (!cause_already_at_competitors && _tasks.at(task_str).competitor.size() > 1))
-						PWRN("Optimizer: The task %s had already had some competitors but no related_id.", task_str.c_str());
+						SCHED_WRN("Optimizer: The task %s had already had some competitors but no related_id.", task_str.c_str());
 					
 					
 					// add this task to the list of the causation task
@@ -671,7 +918,7 @@ namespace Sched_controller {
 					_related_tasks.at(list_id).tasks.emplace(cause_task_str);
 					_tasks.at(cause_task_str).id_related = list_id;
 					
-					PINF("Optimizer (_deadline_reached): Create new list of _related_tasks (id: %d) for task %s and its competitor %s.", list_id, task_str.c_str(), cause_task_str.c_str());
+					SCHED_INF("Optimizer (_deadline_reached): Create new list of _related_tasks (id: %d) for task %s and its competitor %s.", list_id, task_str.c_str(), cause_task_str.c_str());
 				}
 			}
 			else
@@ -686,7 +933,7 @@ namespace Sched_controller {
 					{
 						// the causation task has no own list
 						if(_tasks.at(cause_task_str).competitor.size() > 0)
-							PWRN("Optimizer: Optimizer: The task %s had already had some competitors but no related_id.", cause_task_str.c_str());
+							SCHED_WRN("Optimizer: Optimizer: The task %s had already had some competitors but no related_id.", cause_task_str.c_str());
 						
 						
 						// add competing task to the list of the considered task
@@ -747,7 +994,7 @@ namespace Sched_controller {
 		// increase value and check max_value
 		_tasks.at(task_str).value[_tasks.at(task_str).core] ++;
 		if(_tasks.at(task_str).id_related <= 0)
-			PWRN("Optimizer: The task %s has no id_related althought it should have been updated priorly.", task_str.c_str());
+			SCHED_WRN("Optimizer: The task %s has no id_related althought it should have been updated priorly.", task_str.c_str());
 		else
 			_reset_values(task_str);
 		
@@ -755,12 +1002,14 @@ namespace Sched_controller {
 		_set_to_schedule(task_str);
 	}
 	
-	void Sched_opt::_remove_task(std::string task_str, unsigned int foc_id, Cause_of_death cause)
+	void Sched_opt::_remove_task(std::string task_str, unsigned int foc_id, Cause_of_death cause, bool report)
 	{
-		// memorize the id of the list of related tasks of the ended task (since this task is removed afterwards) 
+		// memorize the id of the list of related tasks and the number of competitors of the ended task (since this task is removed afterwards) 
 		unsigned int tasks_id_related = _tasks.at(task_str).id_related;
+		unsigned int num_competitors = _tasks.at(task_str).competitor.size();
 		
 		// remove task from _tasks list
+		delete[] _tasks.at(task_str).value;
 		_tasks.erase(task_str);
 		
 		// insert it to the list of ended tasks
@@ -807,11 +1056,14 @@ namespace Sched_controller {
 			if(_related_tasks.at(tasks_id_related).tasks.size() <= 1)
 			{
 				// update id of last task at this list and remove list
-				std::string residual_task = *(_related_tasks.at(tasks_id_related).tasks.begin());
-				_tasks.at(residual_task).id_related = 0;
+				for(const std::string& residual_task: _related_tasks.at(tasks_id_related).tasks)
+				{
+					if(_tasks.count(residual_task))
+						_tasks.at(residual_task).id_related = 0;
+				}
 				_related_tasks.erase(tasks_id_related);
 			}
-			else if ((_tasks.at(task_str).competitor.size()+1) >= _related_tasks.at(tasks_id_related).max_value)
+			else if ((num_competitors+1) >= _related_tasks.at(tasks_id_related).max_value)
 			{
 				unsigned int new_max = 0;
 				for(const std::string& task: _related_tasks.at(tasks_id_related).tasks)
@@ -825,6 +1077,11 @@ namespace Sched_controller {
 			}
 		}
 		
+		// tell the controller, so the run queue gives back the capacity of the task
+		if (_departure && report)
+		{
+			_departure->departed(task_str, cause);
+		}
 	}
 	
 	
@@ -843,7 +1100,7 @@ namespace Sched_controller {
 			_tasks.at(task_str).newest_job.core = _threads[thread_nr].affinity.xpos();
 			_tasks.at(task_str).newest_job.arrival_time = _threads[thread_nr].arrival_time;
 			_tasks.at(task_str).newest_job.dispatched = false;
-			PINF("Optimizer: Task %s has a new job with foc_id %d, (arrival: %llu, core: %u).", task_str.c_str(), _threads[thread_nr].foc_id, _tasks.at(task_str).newest_job.arrival_time, _tasks.at(task_str).newest_job.core);
+			SCHED_DBG("Optimizer: Task %s has a new job with foc_id %d, (arrival: %llu, core: %u).", task_str.c_str(), _threads[thread_nr].foc_id, _tasks.at(task_str).newest_job.arrival_time, _tasks.at(task_str).newest_job.core);
 		}
 	}
 	
@@ -898,7 +1155,7 @@ namespace Sched_controller {
 			{
 				case FAIRNESS:
 				{
-					PDBG("The optimization goal 'fairness' is used.");
+					SCHED_DBG("The optimization goal 'fairness' is used.");
 					
 					if(max_value_str.empty()) // this task is the one with max value
 					{
@@ -919,7 +1176,7 @@ namespace Sched_controller {
 				}
 				case UTILIZATION:
 				{
-					PDBG("The optimization goal 'utilization' is used.");
+					SCHED_DBG("The optimization goal 'utilization' is used.");
 					
 					if(max_util_str.empty()) // this task is the one with max utilization
 					{
@@ -939,10 +1196,11 @@ namespace Sched_controller {
 					break;
 				}
 				default:
-					PDBG("No optimization goal is set, hence the task scheduling is not influenced.");
+					SCHED_DBG("No optimization goal is set, hence the task scheduling is not influenced.");
 				
 			}
 		}
+		SCHED_TRACE(SET_TO_SCHEDULE, _tasks.at(task_str).core, _tasks.at(task_str).newest_job.foc_id, task_str.c_str(), _tasks.at(task_str).to_schedule, 0);
 	}
 	
 	
@@ -980,6 +1238,7 @@ namespace Sched_controller {
 			}
 			
 		}
+		SCHED_TRACE(RESET_VALUES, core, _tasks.at(task_str).newest_job.foc_id, task_str.c_str(), _tasks.at(task_str).value[core], 0);
 	}
 	
 	
@@ -1038,7 +1297,7 @@ namespace Sched_controller {
 		
 		// check rip list for cause task whith exit_time in desired interval
 		// fill rip list with data
-		_mon_manager->update_dead(_dead_ds_cap);
+		_update_dead();
 
 		// query rip list
 		for (unsigned int i=1; i<rip[0]*2+1; i+=2)
@@ -1062,7 +1321,7 @@ namespace Sched_controller {
 		if((latest_rip_time <= 0) && (cause_thread_nr <= 0))
 		{
 			// No Thread in considered time interval was found in any of the lists
-			PWRN("Optimizer(_get_cause_task): Didn't find a task which job was executed shortly before the job of task %s (neither in monitoring nor in rip list).", task_str.c_str());
+			SCHED_WRN("Optimizer(_get_cause_task): Didn't find a task which job was executed shortly before the job of task %s (neither in monitoring nor in rip list).", task_str.c_str());
 			return std::string();
 		}
 		//else: determine which thread was executed more recently
@@ -1074,7 +1333,7 @@ namespace Sched_controller {
 				return _threads[cause_thread_nr].thread_name.string();
 			}
 			// else: Thread doesn't match to a task at _tasks list
-			PWRN("Optimizer(_get_cause_task): Causation thread at _threads (%s) is not at _tasks list.", _threads[cause_thread_nr].thread_name.string());
+			SCHED_WRN("Optimizer(_get_cause_task): Causation thread at _threads (%s) is not at _tasks list.", _threads[cause_thread_nr].thread_name.string());
 		}
 		if ( (cause_thread_nr <= 0) || (_threads[cause_thread_nr].exit_time <= latest_rip_time))
 		{
@@ -1091,7 +1350,7 @@ namespace Sched_controller {
 			{
 				if(task.second.last_foc_id == job_foc_id)
 				{
-					PWRN("Optimizer(_get_cause_task): The task, which job was executed shortly before the job of task %s is already dead/finished.", task_str.c_str());
+					SCHED_WRN("Optimizer(_get_cause_task): The task, which job was executed shortly before the job of task %s is already dead/finished.", task_str.c_str());
 				}
 			}
 		}
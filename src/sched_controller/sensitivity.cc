@@ -0,0 +1,127 @@
+/*
+ * \brief  Sensitivity analysis of the run queues
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/printf.h>
+
+#include "sched_controller/sensitivity.h"
+
+namespace Sched_controller
+{
+
+	/**
+	 * Compute the WCET slack of every task of a run queue.
+	 * The wcet of a task can only affect the task itself and
+	 * the tasks with lower or equal priority, so only these are
+	 * checked in each bisection step.
+	 */
+	void Sched_sensitivity::_compute_slack(int rq, Rq_view const *view)
+	{
+		_tasks = *view;
+		int num_tasks = _tasks.size();
+
+		_cache[rq].wcet_slack.clear();
+		for (int k = 0; k < num_tasks; k++) {
+
+			unsigned long long wcet = _tasks.wcet[k];
+			unsigned long long lo = 0;
+			unsigned long long hi = (_tasks.deadline[k] > wcet) ? _tasks.deadline[k] - wcet : 0;
+
+			if (!_alg.task_set_schedulable(&_tasks, k)) {
+				hi = 0;
+			}
+
+			/* largest extra wcet that keeps the run queue schedulable */
+			while (lo < hi) {
+				unsigned long long mid = lo + (hi - lo + 1) / 2;
+				_tasks.wcet[k] = wcet + mid;
+				if (_alg.task_set_schedulable(&_tasks, k)) {
+					lo = mid;
+				} else {
+					hi = mid - 1;
+				}
+			}
+			_tasks.wcet[k] = wcet;
+
+			_cache[rq].wcet_slack[_tasks.name[k].str] = lo;
+		}
+		_cache[rq].slack_valid = true;
+	}
+
+	void Sched_sensitivity::invalidate(int rq)
+	{
+		if (rq < 0 || rq >= (int)_cache.size()) {
+			return;
+		}
+		_cache[rq].slack_valid = false;
+		_cache[rq].wcet_slack.clear();
+		_cache[rq].headroom.clear();
+	}
+
+	long long Sched_sensitivity::wcet_slack(int rq, Rq_view const *view, std::string name)
+	{
+		if (rq < 0 || rq >= (int)_cache.size()) {
+			return -1;
+		}
+		if (!_cache[rq].slack_valid) {
+			_compute_slack(rq, view);
+		}
+
+		auto it = _cache[rq].wcet_slack.find(name);
+		if (it == _cache[rq].wcet_slack.end()) {
+			return -1;
+		}
+		return it->second;
+	}
+
+	unsigned long long Sched_sensitivity::headroom(int rq, Rq_view const *view, unsigned long long period)
+	{
+		if (rq < 0 || rq >= (int)_cache.size() || period == 0) {
+			return 0;
+		}
+
+		auto it = _cache[rq].headroom.find(period);
+		if (it != _cache[rq].headroom.end()) {
+			return it->second;
+		}
+
+		/*
+		 * The new task is put at the lowest priority, so it
+		 * does not interfere with any admitted task and only
+		 * its own response time has to be checked.
+		 */
+		_tasks = *view;
+		Rq_task::Rq_task new_task { };
+		new_task.inter_arrival = period;
+		new_task.deadline = period;
+		new_task.prio = _tasks.size() ? _tasks.prio[_tasks.size() - 1] - 1 : 0;
+		_tasks.push_back(new_task);
+		int probe = _tasks.size() - 1;
+
+		unsigned long long lo = 0;
+		unsigned long long hi = period;
+		while (lo < hi) {
+			unsigned long long mid = lo + (hi - lo + 1) / 2;
+			_tasks.wcet[probe] = mid;
+			if (_alg.task_set_schedulable(&_tasks, probe)) {
+				lo = mid;
+			} else {
+				hi = mid - 1;
+			}
+		}
+
+		_cache[rq].headroom[period] = lo;
+		return lo;
+	}
+
+	Sched_sensitivity::Sched_sensitivity(int num_rqs)
+	: _cache(num_rqs)
+	{
+		for (auto &cache : _cache) {
+			cache.slack_valid = false;
+		}
+	}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * \brief  Statistics of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <cstring>
+
+#include "sched_controller/stats.h"
+
+namespace Sched_controller { namespace Sched_stats {
+
+	Stats::Stats(int num_cores)
+	{
+		Genode::size_t size = sizeof(Header) + num_cores * sizeof(Core_stats);
+		_ds_cap = Genode::env()->ram_session()->alloc(size);
+		_header = Genode::env()->rm_session()->attach(_ds_cap);
+		std::memset(_header, 0, size);
+		_cores = (Core_stats *)(_header + 1);
+
+		_header->magic = MAGIC;
+		_header->version = VERSION;
+		_header->num_cores = num_cores;
+		for (int i = 0; i < num_cores; i++) {
+			_cores[i].core = i;
+			_cores[i].num_cores = num_cores;
+		}
+
+		_copy_cap = Genode::env()->ram_session()->alloc(size);
+		_copy = Genode::env()->rm_session()->attach(_copy_cap);
+		std::memcpy(_copy, _header, size);
+	}
+
+	Stats::~Stats()
+	{
+		Genode::env()->rm_session()->detach(_copy);
+		Genode::env()->ram_session()->free(_copy_cap);
+		Genode::env()->rm_session()->detach(_header);
+		Genode::env()->ram_session()->free(_ds_cap);
+	}
+
+	Genode::Dataspace_capability Stats::publish()
+	{
+		Core_stats *to = (Core_stats *)(_copy + 1);
+		*_copy = *_header;
+		for (unsigned core = 0; core < _header->num_cores; core++)
+			to[core] = snapshot(core);
+		return _copy_cap;
+	}
+
+	Core_stats Stats::snapshot(unsigned core)
+	{
+		Core_stats copy;
+		std::memset(&copy, 0, sizeof(copy));
+		copy.num_cores = _header->num_cores;
+		if (core >= _header->num_cores)
+			return copy;
+
+		Genode::uint32_t const *from = (Genode::uint32_t const *)&_cores[core];
+		Genode::uint32_t *to = (Genode::uint32_t *)&copy;
+		for (unsigned i = 0; i < sizeof(Core_stats) / sizeof(Genode::uint32_t); i++)
+			to[i] = __atomic_load_n(&from[i], __ATOMIC_RELAXED);
+		return copy;
+	}
+
+} }
@@ -1,3 +1,6 @@
 TARGET = sched_controller
-SRC_CC = main.cc sched_controller.cc pcore.cc task_allocator.cc sched_alg.cc sched_opt.cc
-LIBS   = base stdcxx
+SRC_CC = main.cc sched_controller.cc pcore.cc task_allocator.cc admission_pool.cc background_admission.cc sched_alg.cc sched_opt.cc opt_timeout.cc sensitivity.cc wcet_estimator.cc opt_recorder.cc trace.cc stats.cc
+LIBS   = base stdcxx config
+
+# 0 none, 1 errors, 2 warnings, 3 info, 4 debug with the hot-path ring
+CC_OPT += -DSCHED_LOG_LEVEL=2
@@ -8,27 +8,68 @@
 #include <vector>
 #include <base/printf.h>
 
+#include "sched_controller/log.h"
 #include "sched_controller/task_allocator.h"
 #include "sched_controller/sched_controller.h"
 #include "rq_task/rq_task.h"
 
 namespace Sched_controller {
 
+	/**
+	 * Put a task on a pcore without run queues that admits it, the
+	 * one with the lowest id. It gets a run queue for its kind.
+	 *
+	 * \return  0 if the task was enqueued
+	 *         -1 if no unused pcore admits it
+	 *         the status of Sched_controller::task_to_rq otherwise
+	 */
+	int Task_allocator::_to_unused_pcore(Sched_controller *sc, Rq_task::Rq_task *task)
+	{
+		std::vector<Admission_pool::Verdict> verdicts;
+		for (Pcore *p : sc->get_unused_cores()) {
+			verdicts.push_back({ p->get_id(), false, 0 });
+		}
+		if (verdicts.empty()) {
+			SCHED_INF("No empty pcore available");
+			return -1;
+		}
+		sc->evaluate_cores(task, &verdicts);
+
+		int pcore = -1;
+		for (auto &verdict : verdicts) {
+			if (verdict.admissible && (pcore < 0 || verdict.core < pcore)) {
+				pcore = verdict.core;
+			}
+		}
+		if (pcore < 0) {
+			SCHED_INF("No empty pcore admits the task %s", task->name);
+			return -1;
+		}
+
+		SCHED_INF("There are empty pcores on the system, creating a run queue on pcore %d", pcore);
+		int rq = sc->create_runqueue(pcore, task->task_class, task->task_strategy, true);
+		if (rq < 0) {
+			return -1;
+		}
+		int result = sc->task_to_rq(pcore, task);
+		if (result != 0) {
+			sc->destroy_runqueue(rq);
+		}
+		return result;
+	}
+
 	/**
 	 * Allocate the given task to a suitable run queue of the calling Sched_controller
 	 *
 	 * \param *sc: The Sched_controller that is calling this function, i.e. "this"
 	 * \param *task: Pointer to the task that should be initially allocated to a run queue
+	 *
+	 * \return  0 if the task was enqueued
+	 *         <0 in any other case
 	 */
-	void Task_allocator::allocate_task(Sched_controller *sc, Rq_task::Rq_task *task)
+	int Task_allocator::allocate_task(Sched_controller *sc, Rq_task::Rq_task *task)
 	{
-		PINF("Task allocator got the Task with id: %d prio: %d\n", task->task_id, task->prio);
-
-		/* First we need to check for the Task_class of the task */
-		if (task->task_class == Rq_task::Task_class::hi) {
-			PINF("This is a high task => can currently not be allocated!");
-			return;
-		}
+		SCHED_INF("Task allocator got the Task with id: %d prio: %d", task->task_id, task->prio);
 
 		/* 
 		 * Now we need to see if there exists any run queue that
@@ -37,24 +78,73 @@ namespace Sched_controller {
 		std::vector<Runqueue> rqs;
 		sc->which_runqueues(&rqs, task->task_class, task->task_strategy);
 
+		/* hi tasks are admitted into the run queues of the pcores too, see Sched_controller::_admit */
+		if (rqs.size() == 0 && task->task_class == Rq_task::Task_class::hi) {
+			sc->which_runqueues(&rqs, Rq_task::Task_class::lo, Rq_task::Task_strategy::priority);
+		}
+
 		if (rqs.size() == 0) {
 			/* check for empty pcore and put the task there. */
-			std::forward_list<Pcore*> empty_pcore = sc->get_unused_cores();
-
-			if (empty_pcore.empty() == true) {
-				PINF("No empty pcore available");
-				/* TODO: Now we need to reject the task somehow. */
-			} else {
-				PINF("There are empty pcores on the system.");
-				/* 
-				 * TODO: Need to create new runqueue, associate it with the pcore that consumes the
-				 *       lowest energy and enqueue the task into that run queue
-				 */
- 
-			}
+			return _to_unused_pcore(sc, task);
 
 		} else {
+			/*
+			 * Run the admission test of every candidate core, see
+			 * Sched_controller::evaluate_cores, and put the task on the
+			 * admissible core with the largest headroom for its period.
+			 * Several run queues of a pcore share its core.
+			 */
+			std::vector<Admission_pool::Verdict> verdicts;
+			for (auto it = rqs.begin(); it != rqs.end(); it++) {
+				int core = (*it).rq_buffer;
+				if (core < 0 || core >= sc->get_num_cores()) {
+					continue;
+				}
+				bool listed = false;
+				for (auto &verdict : verdicts) {
+					listed = listed || verdict.core == core;
+				}
+				if (!listed) {
+					verdicts.push_back({ core, false, 0 });
+				}
+			}
+			sc->evaluate_cores(task, &verdicts);
+
+			int best_rq = -1;
+			unsigned long long best_headroom = 0;
+			for (auto &verdict : verdicts) {
+				if (verdict.admissible && (best_rq < 0 || verdict.headroom > best_headroom)) {
+					best_rq = verdict.core;
+					best_headroom = verdict.headroom;
+				}
+			}
+
+			if (best_rq >= 0) {
+				SCHED_INF("The Runqueue with the largest headroom is: %d (%llu)", best_rq, best_headroom);
+				return sc->task_to_rq(best_rq, task);
+			}
+
+			/* no run queue of its kind admits the task, a pcore without run queues may */
+			if (_to_unused_pcore(sc, task) == 0) {
+				return 0;
+			}
+
+			if (task->task_class == Rq_task::Task_class::hi) {
+				SCHED_INF("No run queue admits the hi task %s", task->name);
+				if (!sc->semi_partitioned()) {
+					return -1;
+				}
+
+				/* semi-partitioned placement, split the task over two run queues */
+				std::vector<int> cores;
+				for (auto &verdict : verdicts) {
+					cores.push_back(verdict.core);
+				}
+				return sc->split_task(task, cores);
+			}
+
 			/* 
+			 * No run queue has enough headroom, the lo task is best effort.
 			 * Check which runque has the lowest utilization and put it there.
 			 * TODO: If the RQ is a priority based rq, we can't check for the
 			 *       utilization by means of execution times. Instead we should
@@ -66,7 +156,7 @@ namespace Sched_controller {
 			for(int i=0;i<sc->get_num_cores();i++)
 			{
 				int new_util=sc->get_utilization(i);
-				Genode::printf("util: %d\n",new_util);
+				SCHED_DBG("util: %d",new_util);
 				if(new_util<util)
 				{
 					util=new_util;
@@ -88,9 +178,9 @@ namespace Sched_controller {
 
 			}
 
-			PINF("The Runqueue with the lowest utilization is: %d", lowest_util_rq);
+			SCHED_INF("The Runqueue with the lowest utilization is: %d", lowest_util_rq);
 			
-			sc->task_to_rq(lowest_util_rq, task);
+			return sc->task_to_rq(lowest_util_rq, task);
 
 		}
 
@@ -0,0 +1,38 @@
+/*
+ * \brief  Event trace of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <cstring>
+
+#include "sched_controller/trace.h"
+
+namespace Sched_controller { namespace Sched_trace {
+
+	Tracer::Tracer(Genode::size_t size, int num_cores)
+	{
+		/* the largest power of two of events that fits into the share of a core */
+		Genode::size_t share = (size - sizeof(Header)) / num_cores;
+		Genode::uint32_t ring_size = 1;
+		while (ring_bytes(ring_size * 2) <= share)
+			ring_size *= 2;
+
+		_ds_cap = Genode::env()->ram_session()->alloc(size);
+		_header = Genode::env()->rm_session()->attach(_ds_cap);
+		std::memset(_header, 0, size);
+
+		_header->magic = MAGIC;
+		_header->version = VERSION;
+		_header->num_cores = num_cores;
+		_header->ring_size = ring_size;
+	}
+
+	Tracer::~Tracer()
+	{
+		Genode::env()->rm_session()->detach(_header);
+		Genode::env()->ram_session()->free(_ds_cap);
+	}
+
+} }
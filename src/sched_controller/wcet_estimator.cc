@@ -0,0 +1,120 @@
+/*
+ * \brief  Online estimation of the WCET of lo tasks
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "sched_controller/log.h"
+#include "sched_controller/wcet_estimator.h"
+
+namespace Sched_controller
+{
+
+	/**
+	 * Upper confidence bound of the quantile: with n jobs, the
+	 * number of jobs below the quantile is binomial, its 99% bound
+	 * is approximated by n p + 2.33 sqrt(n p (1 - p)). The value of
+	 * that order statistic is rounded up to the end of its bucket.
+	 * If it is a censored job, its value is unknown.
+	 */
+	unsigned long long Wcet_estimator::_estimate(Sketch const &s)
+	{
+		if (s.total < _config.min_samples)
+			return 0;
+
+		double p = _config.quantile / 1000.0;
+		double k = std::ceil(s.total * p + 2.33 * std::sqrt(s.total * p * (1 - p)));
+		if (k > s.total)
+			return 0;
+
+		unsigned long long seen = 0;
+		unsigned i = 0;
+		for (; i < BUCKETS; i++) {
+			seen += s.counts[i];
+			if (seen >= k)
+				break;
+		}
+		if (i == BUCKETS)
+			return 0;
+		unsigned long long bound = (i < BUCKETS - 1) ? Log_histogram::floor(i + 1) - 1 : s.max;
+		if (bound > s.max)
+			bound = s.max;
+		return bound * _config.margin / 100;
+	}
+
+	Wcet_estimator::Sketch &Wcet_estimator::_sketch(std::string const &name)
+	{
+		auto it = _sketches.find(name);
+		if (it == _sketches.end()) {
+			Sketch s;
+			std::memset(&s, 0, sizeof(s));
+			it = _sketches.insert({ name, s }).first;
+		}
+		return it->second;
+	}
+
+	void Wcet_estimator::_age(Sketch &s)
+	{
+		if (s.total < _config.window)
+			return;
+		s.censored /= 2;
+		s.total = s.censored;
+		for (unsigned i = 0; i < BUCKETS; i++) {
+			s.counts[i] /= 2;
+			s.total += s.counts[i];
+		}
+	}
+
+	void Wcet_estimator::add(std::string const &name, unsigned long long execution_time)
+	{
+		Sketch &s = _sketch(name);
+
+		_age(s);
+		s.counts[Log_histogram::index(execution_time)]++;
+		s.total++;
+		if (execution_time > s.max)
+			s.max = execution_time;
+		_publish(name, s);
+	}
+
+	void Wcet_estimator::add_censored(std::string const &name)
+	{
+		Sketch &s = _sketch(name);
+
+		_age(s);
+		s.censored++;
+		s.total++;
+		_publish(name, s);
+	}
+
+	void Wcet_estimator::_publish(std::string const &name, Sketch &s)
+	{
+		/* only changes beyond 1/16 are published, every one costs a rebuild of the run queue view */
+		unsigned long long estimate = _estimate(s);
+		unsigned long long diff = (estimate > s.published) ? estimate - s.published : s.published - estimate;
+		if (diff > s.published / 16) {
+			SCHED_DBG("Wcet_estimator: task %s, estimate %llu after %u jobs, %u missed",
+			          name.c_str(), estimate, s.total, s.censored);
+			s.published = estimate;
+			_changed.push_back(name);
+		}
+	}
+
+	unsigned long long Wcet_estimator::effective(std::string const &name, unsigned long long declared) const
+	{
+		auto it = _sketches.find(name);
+		if (it == _sketches.end() || it->second.published == 0 || it->second.published > declared)
+			return declared;
+		return it->second.published;
+	}
+
+	void Wcet_estimator::take_changed(std::vector<std::string> *names)
+	{
+		names->insert(names->end(), _changed.begin(), _changed.end());
+		_changed.clear();
+	}
+
+}
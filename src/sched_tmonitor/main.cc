@@ -13,9 +13,50 @@
 #include <cpu_session/connection.h>
 #include <trace_session/connection.h>
 #include <timer_session/connection.h>
+#include <os/config.h>
+
+#include "sched_tmonitor/sampler.h"
 
 using namespace Genode;
 
+/**
+ * Lower bound in cycles of the bucket that holds the given percentile
+ */
+static unsigned long long percentile(Genode::uint32_t const *hist, unsigned permille)
+{
+	unsigned long long total = 0;
+	for (unsigned i = 0; i < Sched_controller::Sched_stats::BUCKETS; i++)
+		total += hist[i];
+	if (total == 0)
+		return 0;
+
+	unsigned long long seen = 0;
+	for (unsigned i = 0; i < Sched_controller::Sched_stats::BUCKETS; i++) {
+		seen += hist[i];
+		if (seen * 1000 >= total * permille)
+			return Sched_controller::Sched_stats::bucket_floor(i);
+	}
+	return Sched_controller::Sched_stats::bucket_floor(Sched_controller::Sched_stats::BUCKETS - 1);
+}
+
+static void print_stats(Sched_controller::Connection &sc)
+{
+	unsigned num_cores = 1;
+	for (unsigned core = 0; core < num_cores; core++) {
+		Sched_controller::Sched_stats::Core_stats s = sc.get_stats(core);
+		num_cores = s.num_cores;
+		if (core >= num_cores)
+			break;
+
+		printf("core:%u admitted:%u rejected:%u sufficient:%u rta:%u locked:%u full:%u misses:%u deploys:%u "
+		       "admission_p50:%llu admission_p99:%llu rta_p50:%llu rta_p99:%llu (cycles)\n",
+		       core, s.admitted, s.rejected, s.sufficient, s.rta, s.rq_locked, s.rq_full,
+		       s.deadline_misses, s.deploys,
+		       percentile(s.admission_hist, 500), percentile(s.admission_hist, 990),
+		       percentile(s.rta_hist, 500), percentile(s.rta_hist, 990));
+	}
+}
+
 int main(void)
 {
 
@@ -23,29 +64,61 @@ int main(void)
 
 	Timer::Connection timer;
 
-	static Genode::Trace::Connection trace(1024*4096, 64*4096, 0); 
+	/*
+	 * <config period_ms="100" report_ms="2000" top="10" subjects="256"
+	 *         history="4096" rescan_ms="1000" report_size="256K"/>
+	 */
+	Sched_tmonitor::Sampler_config config;
+	unsigned long period_ms = 100;  /* sampling period */
+	unsigned long report_ms = 2000; /* CSV report, controller statistics and top subjects */
+	unsigned top = 10;
+
+	try {
+		Genode::Xml_node node = Genode::config()->xml_node();
+		period_ms           = node.attribute_value("period_ms", period_ms);
+		report_ms           = node.attribute_value("report_ms", report_ms);
+		top                 = node.attribute_value("top", top);
+		config.max_subjects = node.attribute_value("subjects", config.max_subjects);
+		config.history      = node.attribute_value("history", config.history);
+		config.rescan_ms    = node.attribute_value("rescan_ms", config.rescan_ms);
+		config.report_size  = node.attribute_value("report_size", Genode::Number_of_bytes(config.report_size));
+	} catch (...) {
+		PWRN("sched_tmonitor: no valid config, using the defaults");
+	}
+
+	if (period_ms == 0 || config.max_subjects == 0 || config.history == 0) {
+		PERR("sched_tmonitor: period_ms, subjects and history must be positive");
+		return 1;
+	}
+
+	/* the argument buffer holds the subject ids */
+	static Genode::Trace::Connection trace(1024*4096, config.max_subjects * sizeof(Trace::Subject_id) + 4096, 0);
 
-	Trace::Subject_id subjects[32]; 
-	size_t num_subjects = trace.subjects(subjects, 32);
+	Sched_tmonitor::Sampler sampler(trace, config);
 
+	/* release the samples on absolute times, so the period does not drift */
+	unsigned long next_sample = timer.elapsed_ms();
+	unsigned long next_report = next_sample + report_ms;
 	while(1) {
-		for (size_t i = 0; i < num_subjects; i++) { 
-			Trace::CPU_info info = trace.cpu_info(subjects[i]); 
-			Trace::RAM_info ram_info = trace.ram_info(subjects[i]); 
-
-			printf("ID:%d %lld prio:%d %s name:%s %d %d", 
-			       info.id(), 
-			       info.execution_time(), 
-			       info.prio(), 
-			       info.session_label().string(), 
-			       info.thread_name().string(), 
-			       ram_info.ram_quota(), 
-			       ram_info.ram_used()); 
-		}
+		sampler.sample(timer.elapsed_ms());
 
-		sc.get_init_status();
-		timer.msleep(2000);
+		unsigned long now = timer.elapsed_ms();
+		if (now >= next_report) {
+			unsigned long samples = sampler.report();
+			printf("sched_tmonitor: %u subjects, %lu samples reported, %lu trace RPCs\n",
+			       sampler.num_subjects(), samples, sampler.rpcs());
+			sampler.print_top(top);
+			sc.get_init_status();
+			print_stats(sc);
+			next_report += report_ms;
+		}
 
+		next_sample += period_ms;
+		now = timer.elapsed_ms();
+		if (next_sample > now)
+			timer.msleep(next_sample - now);
+		else
+			next_sample = now;
 	}
 
 	return 0;
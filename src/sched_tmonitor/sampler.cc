@@ -0,0 +1,187 @@
+/*
+ * \brief  Sampler of the CPU share of the trace subjects
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/snprintf.h>
+
+#include "sched_tmonitor/sampler.h"
+
+namespace Sched_tmonitor {
+
+	void Sampler::_rescan(unsigned long now_ms)
+	{
+		unsigned n = _trace.subjects(_ids, _config.max_subjects);
+		_rpcs++;
+
+		/* keep the execution time of the subjects that are still there */
+		for (unsigned i = 0; i < n; i++) {
+			Subject &s = _scratch[i];
+			unsigned j = 0;
+			while (j < _num_subjects && _subjects[j].id.id != _ids[i].id)
+				j++;
+
+			if (j < _num_subjects) {
+				s = _subjects[j];
+			} else {
+				s.id = _ids[i];
+				s.exec_us = 0;
+				s.prio = 0;
+				s.share = 0;
+				s.fresh = true;
+				s.name[0] = 0;
+			}
+
+			try {
+				Genode::Trace::RAM_info ram = _trace.ram_info(s.id);
+				s.ram_used = ram.ram_used();
+				_rpcs++;
+			} catch (Genode::Trace::Nonexistent_subject) {
+				s.ram_used = 0;
+			}
+		}
+
+		Subject *old = _subjects;
+		_subjects = _scratch;
+		_scratch = old;
+		_num_subjects = n;
+		_last_rescan_ms = now_ms;
+		_rescan_needed = false;
+	}
+
+	void Sampler::_push(Sample const &sample)
+	{
+		_history[_next % _config.history] = sample;
+		_next++;
+	}
+
+	void Sampler::sample(unsigned long now_ms)
+	{
+		if (_rescan_needed || now_ms - _last_rescan_ms >= _config.rescan_ms)
+			_rescan(now_ms);
+
+		unsigned long delta_ms = now_ms - _last_sample_ms;
+		_last_sample_ms = now_ms;
+
+		for (unsigned i = 0; i < _num_subjects; i++) {
+			Subject &s = _subjects[i];
+
+			unsigned long long exec_us;
+			try {
+				Genode::Trace::CPU_info info = _trace.cpu_info(s.id);
+				_rpcs++;
+				exec_us = info.execution_time().value;
+				s.prio = info.prio();
+				if (s.fresh)
+					Genode::strncpy(s.name, info.thread_name().string(), sizeof(s.name));
+			} catch (Genode::Trace::Nonexistent_subject) {
+				_rescan_needed = true;
+				continue;
+			}
+
+			if (s.fresh) {
+				s.exec_us = exec_us;
+				s.fresh = false;
+				continue;
+			}
+
+			Sample sample;
+			sample.time_ms  = now_ms;
+			sample.subject  = s.id.id;
+			sample.delta_us = exec_us - s.exec_us;
+			sample.prio     = s.prio;
+			sample.reserved = 0;
+			/* us per ms is permille of one CPU */
+			unsigned long long share = delta_ms ? sample.delta_us / delta_ms : 0;
+			sample.share = share > 0xffff ? 0xffff : share;
+			s.share = sample.share;
+			s.exec_us = exec_us;
+
+			_push(sample);
+		}
+	}
+
+	unsigned long Sampler::report()
+	{
+		unsigned long first = _next - _reported > _config.history ? _next - _config.history : _reported;
+		if (first != _reported)
+			PWRN("sched_tmonitor: %lu samples were overwritten before the report", first - _reported);
+
+		Genode::size_t len = Genode::snprintf(_report_buf, _config.report_size,
+		                                      "time_ms,subject,prio,delta_us,share_permille\n");
+		unsigned long i = first;
+		for (; i < _next; i++) {
+			Sample const &s = _history[i % _config.history];
+			Genode::size_t room = _config.report_size - len;
+			Genode::size_t n = Genode::snprintf(_report_buf + len, room, "%u,%u,%u,%llu,%u\n",
+			                                    s.time_ms, s.subject, s.prio,
+			                                    (unsigned long long)s.delta_us, s.share);
+			if (n + 1 >= room)
+				break;
+			len += n;
+		}
+		_report.submit(len);
+
+		/* the samples that did not fit go out with the next report */
+		if (i < _next)
+			PWRN("sched_tmonitor: report_size is too small, %lu samples are deferred", _next - i);
+		_reported = i;
+		return i - first;
+	}
+
+	void Sampler::print_top(unsigned count)
+	{
+		/* selection of the largest shares, the subject list is small */
+		unsigned printed_share = ~0U;
+		unsigned printed = 0;
+		while (printed < count) {
+			unsigned best = ~0U;
+			for (unsigned i = 0; i < _num_subjects; i++) {
+				unsigned share = _subjects[i].share;
+				if (share < printed_share && (best == ~0U || share > _subjects[best].share))
+					best = i;
+			}
+			if (best == ~0U)
+				break;
+
+			/* print all subjects with this share */
+			unsigned share = _subjects[best].share;
+			for (unsigned i = 0; i < _num_subjects && printed < count; i++) {
+				Subject const &s = _subjects[i];
+				if (s.share != share)
+					continue;
+				Genode::printf("subject:%u name:%s prio:%u share:%u.%u%% ram:%lu\n", s.id.id, s.name,
+				               s.prio, s.share / 10, s.share % 10, (unsigned long)s.ram_used);
+				printed++;
+			}
+			printed_share = share;
+		}
+	}
+
+	Sampler::Sampler(Genode::Trace::Connection &trace, Sampler_config const &config)
+	:
+		_trace(trace),
+		_config(config),
+		_report("samples", config.report_size)
+	{
+		Genode::Allocator *heap = Genode::env()->heap();
+		_ids      = (Genode::Trace::Subject_id *)heap->alloc(_config.max_subjects * sizeof(Genode::Trace::Subject_id));
+		_subjects = (Subject *)heap->alloc(_config.max_subjects * sizeof(Subject));
+		_scratch  = (Subject *)heap->alloc(_config.max_subjects * sizeof(Subject));
+		_history  = (Sample *)heap->alloc(_config.history * sizeof(Sample));
+		_report_buf = Genode::env()->rm_session()->attach(_report.dataspace());
+	}
+
+	Sampler::~Sampler()
+	{
+		Genode::env()->rm_session()->detach(_report_buf);
+		Genode::Allocator *heap = Genode::env()->heap();
+		heap->free(_ids, _config.max_subjects * sizeof(Genode::Trace::Subject_id));
+		heap->free(_subjects, _config.max_subjects * sizeof(Subject));
+		heap->free(_scratch, _config.max_subjects * sizeof(Subject));
+		heap->free(_history, _config.history * sizeof(Sample));
+	}
+}
@@ -1,3 +1,3 @@
 TARGET = sched_tmonitor
-SRC_CC = main.cc
-LIBS   = base
+SRC_CC = main.cc sampler.cc
+LIBS   = base config
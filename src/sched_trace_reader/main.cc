@@ -0,0 +1,189 @@
+/*
+ * \brief  Drains the event trace of the sched_controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The rings of the controller (see sched_controller/trace.h) are
+ * drained periodically and converted to the JSON trace event format
+ * that Perfetto and chrome://tracing load. The timeline grows with
+ * every period and is submitted as report "trace". Every core is a
+ * thread of the timeline, admissions and deployments are slices,
+ * everything else instant events.
+ *
+ * <config period_ms="100" timestamp_mhz="1000" report_size="1M"/>
+ *
+ * timestamp_mhz is the frequency of the cycle counter that is read
+ * by Trace::timestamp(), it converts the events to us. Events that
+ * do not fit into the report any more are counted only.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/snprintf.h>
+#include <os/config.h>
+#include <report_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+#include <sched_controller_session/connection.h>
+#include "sched_controller/trace.h"
+
+using namespace Sched_controller;
+
+class Trace_reader
+{
+	private:
+
+		Sched_trace::Header *_trace;
+		Report::Connection _report;
+		char *_buf;
+		Genode::size_t _size;
+		Genode::size_t _len = 0;
+		unsigned long long _mhz;
+		unsigned long long _first = 0;
+		bool _first_seen = false;
+		unsigned long _events = 0;
+		unsigned long _skipped = 0; /* drained, but the report was full */
+
+		void _append(Sched_trace::Event const &e)
+		{
+			if (!_first_seen) {
+				_first = e.cycles;
+				_first_seen = true;
+			}
+			unsigned long long ns = (e.cycles - _first) * 1000 / _mhz;
+
+			const char *ph = "i";
+			if (e.type == Sched_trace::ADMISSION_BEGIN || e.type == Sched_trace::DEPLOY_BEGIN)
+				ph = "B";
+			else if (e.type == Sched_trace::ADMISSION_END || e.type == Sched_trace::DEPLOY_END)
+				ph = "E";
+
+			/* leave room for the closing "]}" */
+			Genode::size_t room = _size - _len - 2;
+			Genode::size_t n = Genode::snprintf(_buf + _len, room,
+				"%s{\"name\":\"%s\",\"ph\":\"%s\",\"s\":\"t\",\"ts\":%llu.%03llu,\"pid\":0,\"tid\":%u,"
+				"\"args\":{\"task\":\"%s\",\"id\":%d,\"a\":%llu,\"b\":%llu}}",
+				_events ? ",\n" : "", Sched_trace::type_name(e.type), ph, ns / 1000, ns % 1000,
+				(unsigned)e.core, e.name, (int)e.task_id,
+				(unsigned long long)e.a, (unsigned long long)e.b);
+
+			if (n + 1 >= room) {
+				_skipped++;
+				return;
+			}
+			_len += n;
+			_events++;
+		}
+
+	public:
+
+		Trace_reader(Genode::Dataspace_capability trace_ds, Genode::size_t report_size,
+		             unsigned long long mhz)
+		:
+			_trace(Genode::env()->rm_session()->attach(trace_ds)),
+			_report("trace", report_size),
+			_buf(Genode::env()->rm_session()->attach(_report.dataspace())),
+			_size(report_size),
+			_mhz(mhz)
+		{
+			_len = Genode::snprintf(_buf, _size, "{\"traceEvents\":[\n");
+		}
+
+		bool valid() const
+		{
+			return _trace->magic == Sched_trace::MAGIC && _trace->version == Sched_trace::VERSION;
+		}
+
+		/**
+		 * Move all events of the rings into the report
+		 *
+		 * \return number of drained events
+		 */
+		unsigned drain()
+		{
+			unsigned drained = 0;
+			for (unsigned core = 0; core < _trace->num_cores; core++) {
+				Sched_trace::Ring *r = Sched_trace::ring(_trace, core);
+				Genode::uint32_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+				Genode::uint32_t tail = r->tail;
+				for (; tail != head; tail++, drained++)
+					_append(r->events()[tail & (_trace->ring_size - 1)]);
+				__atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+			}
+			return drained;
+		}
+
+		void submit()
+		{
+			_buf[_len] = ']';
+			_buf[_len + 1] = '}';
+			_report.submit(_len + 2);
+		}
+
+		unsigned long dropped()
+		{
+			unsigned long dropped = 0;
+			for (unsigned core = 0; core < _trace->num_cores; core++)
+				dropped += Sched_trace::ring(_trace, core)->dropped;
+			return dropped;
+		}
+
+		unsigned long events() const { return _events; }
+		unsigned long skipped() const { return _skipped; }
+};
+
+int main()
+{
+	unsigned period_ms = 100;
+	unsigned long long timestamp_mhz = 1000;
+	Genode::Number_of_bytes report_size = 1024 * 1024;
+
+	try {
+		Genode::Xml_node config = Genode::config()->xml_node();
+		period_ms     = config.attribute_value("period_ms", period_ms);
+		timestamp_mhz = config.attribute_value("timestamp_mhz", timestamp_mhz);
+		report_size   = config.attribute_value("report_size", report_size);
+	} catch (...) {
+		PWRN("sched_trace_reader: no valid config, using the defaults");
+	}
+
+	if (timestamp_mhz == 0 || report_size < 64) {
+		PERR("sched_trace_reader: timestamp_mhz and report_size are too small");
+		return 1;
+	}
+
+	Sched_controller::Connection ctr;
+	Genode::Dataspace_capability trace_ds = ctr.trace();
+	if (!trace_ds.valid()) {
+		PERR("sched_trace_reader: tracing is off, set the trace size in the config of the sched_controller");
+		return 1;
+	}
+
+	Trace_reader reader(trace_ds, report_size, timestamp_mhz);
+	if (!reader.valid()) {
+		PERR("sched_trace_reader: the trace dataspace has an unknown format");
+		return 1;
+	}
+
+	Timer::Connection timer;
+	unsigned long last_dropped = 0, last_skipped = 0;
+	while (true) {
+		timer.msleep(period_ms);
+		if (!reader.drain())
+			continue;
+		reader.submit();
+
+		unsigned long dropped = reader.dropped();
+		if (dropped != last_dropped) {
+			PWRN("sched_trace_reader: %lu events were dropped, drain more often or enlarge the trace",
+			     dropped - last_dropped);
+			last_dropped = dropped;
+		}
+		if (reader.skipped() != last_skipped) {
+			PWRN("sched_trace_reader: report full after %lu events, %lu skipped", reader.events(), reader.skipped());
+			last_skipped = reader.skipped();
+		}
+	}
+	return 0;
+}
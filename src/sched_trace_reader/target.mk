@@ -0,0 +1,3 @@
+TARGET = sched_trace_reader
+SRC_CC = main.cc
+LIBS   = base config
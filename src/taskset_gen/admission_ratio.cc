@@ -0,0 +1,226 @@
+/*
+ * \brief  Admission ratio of the schedulability tests
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <algorithm>
+#include <base/printf.h>
+
+#include "taskset_gen/admission_ratio.h"
+
+namespace Taskset_gen
+{
+
+	const char *test_name(Test test)
+	{
+		switch (test) {
+		case Test::sufficient: return "sufficient";
+		case Test::cascade:    return "cascade";
+		case Test::rta:        return "rta";
+		case Test::edf:        return "edf";
+		case Test::partition:  return "partition";
+		case Test::semi_partition: return "semi_partition";
+		}
+		return "unknown";
+	}
+
+	void Admission_ratio::_clear()
+	{
+		for (unsigned core = 0; core < _rqs.size(); core++) {
+			_rqs[core].clear();
+			_util[core] = 0.0;
+			_sensitivity.invalidate(core);
+		}
+	}
+
+	/**
+	 * Admit the tasks one by one into the first run queue
+	 *
+	 * The tasks are sorted from the highest to the lowest
+	 * priority, so every task is appended at the end of the
+	 * run queue.
+	 */
+	bool Admission_ratio::_admit(Test test, std::vector<Rq_task::Rq_task> &tasks)
+	{
+		Sched_controller::Rq_util util;
+		Sched_controller::Sched_alg::reset_util(&util);
+		Sched_controller::Rq_view *rq = &_rqs[0];
+
+		for (auto &task : tasks) {
+			bool rm = util.rate_monotonic && _alg.rate_monotonic(&task, rq);
+			bool admitted = false;
+
+			unsigned long long start = _now();
+			switch (test) {
+			case Test::sufficient: admitted = _alg.fp_sufficient_test(&task, rq); break;
+			case Test::cascade:    admitted = _alg.fp_admission_test(&task, rq, &util, rm); break;
+			case Test::rta:        admitted = _alg.RTA(&task, rq); break;
+			case Test::edf:        admitted = _alg.edf_test(&task, rq, &util); break;
+			default: break;
+			}
+			_samples.push_back(_now() - start);
+
+			if (!admitted)
+				return false;
+			rq->insert(task);
+			_alg.add_util(&util, &task, rm);
+		}
+		return true;
+	}
+
+	/**
+	 * Exact fp test of a run queue after task was inserted at its priority
+	 */
+	bool Admission_ratio::_fits(unsigned core, Rq_task::Rq_task const &task)
+	{
+		_scratch = _rqs[core];
+		int first_check = _scratch.insert(task);
+		return _alg.task_set_schedulable(&_scratch, first_check);
+	}
+
+	void Admission_ratio::_insert(unsigned core, Rq_task::Rq_task const &task)
+	{
+		_rqs[core].insert(task);
+		_util[core] += (double)task.wcet / (double)task.inter_arrival;
+		_sensitivity.invalidate(core);
+	}
+
+	/**
+	 * Split a task over two cores like Sched_controller::split_task
+	 */
+	bool Admission_ratio::_split(Rq_task::Rq_task &task)
+	{
+		unsigned best = 0;
+		unsigned long long best_budget = 0;
+		for (unsigned core = 0; core < _rqs.size(); core++) {
+			unsigned long long budget = _alg.cd_head_budget(&task, &_rqs[core]);
+			if (budget > best_budget) {
+				best_budget = budget;
+				best = core;
+			}
+		}
+		if (best_budget == 0)
+			return false;
+
+		Rq_task::Rq_task head, tail;
+		Sched_controller::Sched_alg::cd_split(task, best_budget, &_rqs[best], &head, &tail);
+		for (unsigned core = 0; core < _rqs.size(); core++) {
+			if (core != best && _fits(core, tail)) {
+				_insert(best, head);
+				_insert(core, tail);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Place the tasks like the Task_allocator: the core with the
+	 * largest headroom for the period comes first, then the other
+	 * cores by increasing utilization. The exact fp test decides.
+	 * With split, a task that fits on no core is split.
+	 */
+	bool Admission_ratio::_partition(std::vector<Rq_task::Rq_task> &tasks, bool split)
+	{
+		std::vector<Rq_task::Rq_task> order(tasks);
+		std::stable_sort(order.begin(), order.end(), [] (Rq_task::Rq_task const &a, Rq_task::Rq_task const &b) {
+			return a.wcet * b.inter_arrival > b.wcet * a.inter_arrival;
+		});
+
+		std::vector<unsigned> cores(_rqs.size());
+		for (auto &task : order) {
+			unsigned long long start = _now();
+
+			unsigned best = 0;
+			unsigned long long best_headroom = 0;
+			for (unsigned core = 0; core < _rqs.size(); core++) {
+				cores[core] = core;
+				unsigned long long headroom = _sensitivity.headroom(core, &_rqs[core], task.inter_arrival);
+				if (headroom > best_headroom) {
+					best_headroom = headroom;
+					best = core;
+				}
+			}
+			std::stable_sort(cores.begin(), cores.end(), [&] (unsigned a, unsigned b) {
+				if ((a == best) != (b == best))
+					return a == best;
+				return _util[a] < _util[b];
+			});
+
+			bool placed = false;
+			for (unsigned core : cores) {
+				if (_fits(core, task)) {
+					_insert(core, task);
+					placed = true;
+					break;
+				}
+			}
+			if (!placed && split)
+				placed = _split(task);
+			_samples.push_back(_now() - start);
+
+			if (!placed)
+				return false;
+		}
+		return true;
+	}
+
+	Sweep_result Admission_ratio::_result(Test test, double util, unsigned accepted)
+	{
+		Sweep_result result { test, util, _config.sets_per_step, accepted, 0, 0, 0 };
+		if (_samples.empty())
+			return result;
+
+		std::sort(_samples.begin(), _samples.end());
+		unsigned long long sum = 0;
+		for (auto s : _samples)
+			sum += s;
+		result.mean_ns = sum / _samples.size();
+		result.p99_ns = _samples[std::min(_samples.size() - 1, (_samples.size() * 99 + 99) / 100 - 1)];
+		result.max_ns = _samples.back();
+		return result;
+	}
+
+	void Admission_ratio::run(Report report)
+	{
+		const Test tests[] = { Test::sufficient, Test::cascade, Test::rta, Test::edf, Test::partition, Test::semi_partition };
+		std::vector<Rq_task::Rq_task> tasks;
+
+		for (double u = _config.util_min; u <= _config.util_max + 1e-9; u += _config.util_step) {
+			for (Test test : tests) {
+				Params params = _config.params;
+				params.utilization = u;
+				bool partitioned = (test == Test::partition || test == Test::semi_partition);
+				if (partitioned) {
+					params.utilization *= _rqs.size();
+					params.num_tasks *= _rqs.size();
+				}
+				if (test == Test::edf)
+					params.strategy = Rq_task::Task_strategy::deadline;
+
+				/* every test sees the same task sets */
+				_gen = Generator(_config.seed + (unsigned)(u * 1000));
+				_samples.clear();
+				unsigned accepted = 0;
+				for (unsigned set = 0; set < _config.sets_per_step; set++) {
+					if (!_gen.task_set(params, &tasks))
+						continue;
+					_clear();
+					bool ok = partitioned ? _partition(tasks, test == Test::semi_partition) : _admit(test, tasks);
+					if (ok)
+						accepted++;
+				}
+				report(_result(test, u, accepted));
+			}
+		}
+	}
+
+	Admission_ratio::Admission_ratio(Sweep_config const &config, Now_ns now)
+	:
+		_config(config), _now(now), _gen(config.seed),
+		_sensitivity(std::max(config.num_cores, 1U)),
+		_rqs(std::max(config.num_cores, 1U)),
+		_util(std::max(config.num_cores, 1U), 0.0)
+	{ }
+}
@@ -0,0 +1,72 @@
+/*
+ * \brief  Admission ratio benchmark of the schedulability tests
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The sweep is configured via the config ROM:
+ *
+ * <config tasks="8" sets="100" cores="4" seed="1"
+ *         util_min="0.05" util_max="1.0" util_step="0.05"
+ *         period_min="10000" period_max="1000000"
+ *         deadline_ratio_min="1.0" deadline_ratio_max="1.0"
+ *         hi_share="1.0" timestamp_mhz="1000"/>
+ *
+ * timestamp_mhz is the frequency of the cycle counter that is
+ * read by Trace::timestamp(), it converts the latencies to ns.
+ */
+
+#include <base/printf.h>
+#include <os/config.h>
+#include <trace/timestamp.h>
+
+#include "taskset_gen/admission_ratio.h"
+
+static unsigned long long timestamp_mhz = 1000;
+
+static unsigned long long now_ns()
+{
+	return Genode::Trace::timestamp() * 1000 / timestamp_mhz;
+}
+
+static void report(Taskset_gen::Sweep_result const &r)
+{
+	/* the run script parses these lines, utilization and ratio in permille */
+	PINF("admission_ratio test=%s util=%u sets=%u accepted=%u ratio=%u mean_ns=%llu p99_ns=%llu max_ns=%llu",
+	     Taskset_gen::test_name(r.test), (unsigned)(r.utilization * 1000 + 0.5), r.sets, r.accepted,
+	     r.sets ? r.accepted * 1000 / r.sets : 0, r.mean_ns, r.p99_ns, r.max_ns);
+}
+
+int main()
+{
+	Taskset_gen::Sweep_config cfg;
+
+	try {
+		Genode::Xml_node config = Genode::config()->xml_node();
+		cfg.params.num_tasks          = config.attribute_value("tasks", cfg.params.num_tasks);
+		cfg.params.period_min         = config.attribute_value("period_min", cfg.params.period_min);
+		cfg.params.period_max         = config.attribute_value("period_max", cfg.params.period_max);
+		cfg.params.deadline_ratio_min = config.attribute_value("deadline_ratio_min", cfg.params.deadline_ratio_min);
+		cfg.params.deadline_ratio_max = config.attribute_value("deadline_ratio_max", cfg.params.deadline_ratio_max);
+		cfg.params.hi_share           = config.attribute_value("hi_share", cfg.params.hi_share);
+		cfg.util_min      = config.attribute_value("util_min", cfg.util_min);
+		cfg.util_max      = config.attribute_value("util_max", cfg.util_max);
+		cfg.util_step     = config.attribute_value("util_step", cfg.util_step);
+		cfg.sets_per_step = config.attribute_value("sets", cfg.sets_per_step);
+		cfg.num_cores     = config.attribute_value("cores", cfg.num_cores);
+		cfg.seed          = config.attribute_value("seed", cfg.seed);
+		timestamp_mhz     = config.attribute_value("timestamp_mhz", timestamp_mhz);
+	} catch (...) {
+		PWRN("taskset_gen: no valid config, using the defaults");
+	}
+
+	if (timestamp_mhz == 0 || cfg.util_step <= 0.0) {
+		PERR("taskset_gen: timestamp_mhz and util_step must be positive");
+		return 1;
+	}
+
+	Taskset_gen::Admission_ratio bench(cfg, now_ns);
+	bench.run(report);
+
+	PINF("admission_ratio done");
+	return 0;
+}
@@ -0,0 +1,9 @@
+TARGET = taskset_gen
+SRC_CC = main.cc admission_ratio.cc sched_alg.cc sensitivity.cc
+LIBS   = base stdcxx config
+
+# 0 none, 1 errors, 2 warnings, 3 info, 4 debug with the hot-path ring
+CC_OPT += -DSCHED_LOG_LEVEL=2
+
+vpath sched_alg.cc   $(PRG_DIR)/../sched_controller
+vpath sensitivity.cc $(PRG_DIR)/../sched_controller
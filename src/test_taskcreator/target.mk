@@ -1,3 +1,3 @@
 TARGET = test_taskcreator
 SRC_CC = test_taskcreator.cc
-LIBS   = base stdcxx
\ No newline at end of file
+LIBS   = base stdcxx config
\ No newline at end of file
@@ -2,15 +2,250 @@
  * \brief  Creates rq_task objects for the sched_controller
  * \author Paul Nieleck
  * \date   2016/09/15
+ *
+ * Without a config, a random task is submitted every 1..10 s.
+ * With <config mode="load" .../>, the admission of the controller
+ * is load tested:
+ *
+ * <config mode="load" rate="1000" sessions="4" duration_ms="10000"
+ *         util="0.01" hi_share="1.0" seed="1"/>
+ *
+ * rate is the total number of new_task calls per second. The calls
+ * are issued open-loop, i.e. on a fixed schedule that does not wait
+ * for the controller, from several sessions, each served by a
+ * thread of its own. A latency counts from the scheduled time of a
+ * call to its return, so a saturated controller shows up as growing
+ * latencies instead of a lower rate. The result is submitted as
+ * report "admission_load" and logged as one line, which
+ * run/admission_load.run collects.
  */
 
 #include <random>
 #include <timer_session/connection.h>
+#include <base/env.h>
 #include <base/printf.h>
 #include <base/sleep.h>
+#include <base/snprintf.h>
+#include <base/thread.h>
+#include <os/config.h>
+#include <report_session/connection.h>
+#include <util/string.h>
+#include <trace/timestamp.h>
 
 #include "rq_task/rq_task.h"
+#include "sched_controller/log_histogram.h"
 #include "sched_controller_session/connection.h"
+#include "taskset_gen/taskset_gen.h"
+
+/**
+ * Latency histogram with 8 linear sub-buckets per power of two,
+ * i.e. a relative error of at most 12.5%, see log_histogram.h
+ */
+struct Latency_histogram
+{
+	enum { BUCKETS = Sched_controller::Log_histogram::BUCKETS };
+
+	unsigned long counts[BUCKETS];
+	unsigned long total = 0;
+	unsigned long long max = 0;
+
+	Latency_histogram() { for (unsigned i = 0; i < BUCKETS; i++) counts[i] = 0; }
+
+	void add(unsigned long long v)
+	{
+		counts[Sched_controller::Log_histogram::index(v)]++;
+		total++;
+		if (v > max)
+			max = v;
+	}
+
+	void merge(Latency_histogram const &other)
+	{
+		for (unsigned i = 0; i < BUCKETS; i++)
+			counts[i] += other.counts[i];
+		total += other.total;
+		if (other.max > max)
+			max = other.max;
+	}
+
+	unsigned long long percentile(unsigned per_100000) const
+	{
+		unsigned long long seen = 0;
+		for (unsigned i = 0; i < BUCKETS; i++) {
+			seen += counts[i];
+			if (total && seen * 100000 >= (unsigned long long)total * per_100000)
+				return Sched_controller::Log_histogram::floor(i);
+		}
+		return max;
+	}
+};
+
+struct Load_config
+{
+	unsigned rate = 1000;             /* calls per second, all sessions together */
+	unsigned sessions = 4;
+	unsigned long duration_ms = 10000;
+	double util = 0.01;               /* utilization of each submitted task */
+	double hi_share = 1.0;
+	unsigned seed = 1;
+	int num_cores = 1;
+	unsigned long long cycles_per_ms = 1; /* of Trace::timestamp(), per ms to keep the fraction of a MHz */
+	unsigned long long start_us = 0;  /* first scheduled call of all sessions */
+};
+
+static unsigned long long now_us(Load_config const &cfg)
+{
+	/* split, so that the multiplication does not overflow */
+	Genode::Trace::Timestamp t = Genode::Trace::timestamp();
+	return (t / cfg.cycles_per_ms) * 1000 + (t % cfg.cycles_per_ms) * 1000 / cfg.cycles_per_ms;
+}
+
+/**
+ * One client session of the load test
+ */
+class Load_worker : public Genode::Thread<16*1024>
+{
+	private:
+
+		Load_config const &_cfg;
+		unsigned _index;
+
+	public:
+
+		Latency_histogram latency;
+		unsigned long accepted = 0;
+		unsigned long rejected = 0;
+		unsigned long long last_us = 0;   /* return of the last call */
+
+		Load_worker(Load_config const &cfg, unsigned index)
+		:
+			Genode::Thread<16*1024>("load_worker"),
+			_cfg(cfg), _index(index)
+		{ }
+
+		void entry()
+		{
+			Sched_controller::Connection sc;
+			Timer::Connection timer;
+
+			Taskset_gen::Generator gen(_cfg.seed + _index);
+			Taskset_gen::Params params;
+			params.num_tasks = 1;
+			params.utilization = _cfg.util;
+			params.hi_share = _cfg.hi_share;
+			std::vector<Rq_task::Rq_task> tasks;
+
+			/* the sessions take turns, together they issue rate calls per second */
+			unsigned long long interval_us = 1000000ULL * _cfg.sessions / _cfg.rate;
+			unsigned long long offset_us = 1000000ULL * _index / _cfg.rate;
+			unsigned long calls = (unsigned long long)_cfg.duration_ms * _cfg.rate / 1000 / _cfg.sessions;
+
+			for (unsigned long k = 0; k < calls; k++) {
+				unsigned long long due = _cfg.start_us + offset_us + k * interval_us;
+				unsigned long long now = now_us(_cfg);
+				if (due > now + 1000)
+					timer.usleep(due - now);
+				while (now_us(_cfg) < due)
+					;
+
+				gen.task_set(params, &tasks);
+				Rq_task::Rq_task task = tasks[0];
+				task.task_id = (int)(_index << 24 | k);
+				Genode::snprintf(task.name, sizeof(task.name), "load%u_%lu", _index, k);
+
+				int result = sc.new_task(task, (int)(k % _cfg.num_cores));
+
+				last_us = now_us(_cfg);
+				latency.add(last_us - due);
+				if (result == 0)
+					accepted++;
+				else
+					rejected++;
+			}
+		}
+};
+
+static void load_test(Timer::Connection &timer, Sched_controller::Connection &sc)
+{
+	Load_config cfg;
+	Genode::Xml_node config = Genode::config()->xml_node();
+	cfg.rate        = config.attribute_value("rate", cfg.rate);
+	cfg.sessions    = config.attribute_value("sessions", cfg.sessions);
+	cfg.duration_ms = config.attribute_value("duration_ms", cfg.duration_ms);
+	cfg.util        = config.attribute_value("util", cfg.util);
+	cfg.hi_share    = config.attribute_value("hi_share", cfg.hi_share);
+	cfg.seed        = config.attribute_value("seed", cfg.seed);
+	if (cfg.rate == 0 || cfg.sessions == 0 || cfg.sessions > cfg.rate) {
+		PERR("test_taskcreator: rate and sessions must be positive, at most one session per call per second");
+		return;
+	}
+
+	/* the number of cores is part of the statistics */
+	cfg.num_cores = sc.get_stats(0).num_cores;
+	if (cfg.num_cores < 1)
+		cfg.num_cores = 1;
+
+	/* rate of the cycle counter */
+	unsigned long t0 = timer.elapsed_ms();
+	Genode::Trace::Timestamp c0 = Genode::Trace::timestamp();
+	timer.msleep(100);
+	unsigned long t1 = timer.elapsed_ms();
+	Genode::Trace::Timestamp c1 = Genode::Trace::timestamp();
+	cfg.cycles_per_ms = (c1 - c0) / (t1 - t0);
+	if (cfg.cycles_per_ms == 0)
+		cfg.cycles_per_ms = 1;
+
+	/* give the workers time to open their sessions */
+	cfg.start_us = now_us(cfg) + 100000;
+
+	Load_worker **workers = (Load_worker **)Genode::env()->heap()->alloc(cfg.sessions * sizeof(Load_worker *));
+	for (unsigned i = 0; i < cfg.sessions; i++) {
+		workers[i] = new (Genode::env()->heap()) Load_worker(cfg, i);
+		workers[i]->start();
+	}
+
+	Latency_histogram latency;
+	unsigned long accepted = 0, rejected = 0;
+	unsigned long long end_us = cfg.start_us;
+	for (unsigned i = 0; i < cfg.sessions; i++) {
+		workers[i]->join();
+		latency.merge(workers[i]->latency);
+		accepted += workers[i]->accepted;
+		rejected += workers[i]->rejected;
+		if (workers[i]->last_us > end_us)
+			end_us = workers[i]->last_us;
+		Genode::destroy(Genode::env()->heap(), workers[i]);
+	}
+	Genode::env()->heap()->free(workers, cfg.sessions * sizeof(Load_worker *));
+
+	/* achieved rate, below the offered one if the controller saturated */
+	unsigned long long elapsed_us = end_us - cfg.start_us;
+	unsigned long throughput = elapsed_us ? (unsigned long long)latency.total * 1000000 / elapsed_us : 0;
+
+	unsigned long long p50 = latency.percentile(50000);
+	unsigned long long p99 = latency.percentile(99000);
+	unsigned long long p999 = latency.percentile(99900);
+
+	char line[256];
+	Genode::size_t len = Genode::snprintf(line, sizeof(line),
+	                                      "rate=%u sessions=%u calls=%lu accepted=%lu rejected=%lu throughput=%lu "
+	                                      "p50_us=%llu p99_us=%llu p999_us=%llu max_us=%llu",
+	                                      cfg.rate, cfg.sessions, latency.total, accepted, rejected, throughput,
+	                                      p50, p99, p999, latency.max);
+	try {
+		static Report::Connection report("admission_load", sizeof(line));
+		char *buf = Genode::env()->rm_session()->attach(report.dataspace());
+		Genode::memcpy(buf, line, len + 1);
+		report.submit(len);
+		Genode::env()->rm_session()->detach(buf);
+	} catch (...) {
+		PWRN("test_taskcreator: no Report service, the result is only logged");
+	}
+
+	/* the run script parses this line */
+	PINF("admission_load %s", line);
+	PINF("admission_load done");
+}
 
 int main()
 {
@@ -18,31 +253,44 @@ int main()
 	static Timer::Connection _timer;
 	static Sched_controller::Connection _schedcontrlr;
 
+	bool load = false;
+	try {
+		Genode::String<16> mode = Genode::config()->xml_node().attribute_value("mode", Genode::String<16>("random"));
+		load = !Genode::strcmp(mode.string(), "load");
+	} catch (...) { }
+
+	if (load) {
+		load_test(_timer, _schedcontrlr);
+		Genode::sleep_forever();
+	}
+
+	int num_cores = _schedcontrlr.get_stats(0).num_cores;
+	if (num_cores < 1)
+		num_cores = 1;
+
 	std::default_random_engine generator;
 	std::uniform_int_distribution<int> distribution(1000,9999);
 
+	/* single tasks with 1..30% utilization, so wcet <= deadline <= period */
+	Taskset_gen::Generator taskset_gen(1);
+	Taskset_gen::Params params;
+	params.num_tasks = 1;
+	params.deadline_ratio_min = 0.5;
+	params.hi_share = 0.5;
+	std::vector<Rq_task::Rq_task> tasks;
+
 	while (true) {
 
 		int rand = distribution(generator);
 
-		Rq_task::Rq_task task;
+		params.utilization = (rand % 30 + 1) / 100.0;
+		params.strategy = (rand % 3 == 1) ? Rq_task::Task_strategy::deadline
+		                                  : Rq_task::Task_strategy::priority;
+		taskset_gen.task_set(params, &tasks);
 
+		Rq_task::Rq_task task = tasks[0];
 		task.task_id = rand;
-		if (rand % 2 == 0) {
-			task.task_class = Rq_task::Task_class::hi;
-		} else {
-			task.task_class = Rq_task::Task_class::lo;
-		}
-		if (rand % 3 == 0) {
-			task.task_strategy = Rq_task::Task_strategy::priority;
-		} else if (rand % 3 == 1) {
-			task.task_strategy = Rq_task::Task_strategy::deadline;
-		}
-		task.deadline = (float) rand;
-		task.wcet = (float) rand;
-		task.inter_arrival = (int) rand / 1000;
 		task.prio = rand % 128;
-		task.valid = true;
 
 		_timer.msleep(rand);
 
@@ -51,10 +299,12 @@ int main()
 		PINF("       task_strategy: %d", task.task_strategy);
 		PINF("                prio: %d", task.prio);
 
-		_schedcontrlr.new_task(task);
+		int core = rand % num_cores;
+		int result = _schedcontrlr.new_task(task, core);
+		PINF("              result: %s on core %d", result == 0 ? "admitted" : "rejected", core);
 
 	}
 
 	return 0;
 
-}
\ No newline at end of file
+}
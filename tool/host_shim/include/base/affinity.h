@@ -0,0 +1,31 @@
+/*
+ * \brief  Host shim: affinity of a thread
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__AFFINITY_H_
+#define _HOST_SHIM__BASE__AFFINITY_H_
+
+namespace Genode {
+
+	struct Affinity
+	{
+		class Location
+		{
+			private:
+
+				int _xpos = 0, _ypos = 0;
+
+			public:
+
+				Location() { }
+				Location(int xpos, int ypos) : _xpos(xpos), _ypos(ypos) { }
+
+				int xpos() const { return _xpos; }
+				int ypos() const { return _ypos; }
+		};
+	};
+}
+
+#endif /* _HOST_SHIM__BASE__AFFINITY_H_ */
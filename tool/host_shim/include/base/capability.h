@@ -0,0 +1,40 @@
+/*
+ * \brief  Host shim: capabilities
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * A dataspace capability simply carries the address
+ * and size of the backing host memory.
+ */
+
+#ifndef _HOST_SHIM__BASE__CAPABILITY_H_
+#define _HOST_SHIM__BASE__CAPABILITY_H_
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	struct Native_capability
+	{
+		void *local = nullptr;
+		size_t size = 0;
+
+		bool valid() const { return local != nullptr; }
+	};
+
+	template <typename>
+	struct Capability : Native_capability
+	{
+		Capability() { }
+		Capability(Native_capability cap) : Native_capability(cap) { }
+	};
+
+	struct Dataspace;
+	typedef Capability<Dataspace> Dataspace_capability;
+	typedef Dataspace_capability  Ram_dataspace_capability;
+
+	struct Cpu_thread;
+	typedef Capability<Cpu_thread> Thread_capability;
+}
+
+#endif /* _HOST_SHIM__BASE__CAPABILITY_H_ */
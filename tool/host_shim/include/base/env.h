@@ -0,0 +1,71 @@
+/*
+ * \brief  Host shim: environment with RAM, RM and CPU session
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__ENV_H_
+#define _HOST_SHIM__BASE__ENV_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <base/capability.h>
+#include <base/stdint.h>
+#include <cpu_session/cpu_session.h>
+
+namespace Genode {
+
+	struct Local_addr
+	{
+		void *ptr;
+
+		template <typename T>
+		operator T*() const { return (T*)ptr; }
+	};
+
+	struct Rm_session
+	{
+		Local_addr attach(Dataspace_capability ds) { return Local_addr { ds.local }; }
+		void detach(const void *) { }
+	};
+
+	struct Ram_session
+	{
+		Ram_dataspace_capability alloc(size_t size)
+		{
+			Ram_dataspace_capability cap;
+			cap.local = std::calloc(1, size);
+			cap.size  = size;
+			return cap;
+		}
+
+		void free(Ram_dataspace_capability cap) { std::free(cap.local); }
+	};
+
+	struct Parent
+	{
+		void announce(Native_capability) { }
+	};
+
+	struct Env
+	{
+		Rm_session  rm;
+		Ram_session ram;
+		Parent      parent_obj;
+		Cpu_session cpu;
+
+		Rm_session  *rm_session()  { return &rm; }
+		Ram_session *ram_session() { return &ram; }
+		Parent      *parent()      { return &parent_obj; }
+		Cpu_session *cpu_session() { return &cpu; }
+	};
+
+	inline Env *env()
+	{
+		static Env inst;
+		return &inst;
+	}
+}
+
+#endif /* _HOST_SHIM__BASE__ENV_H_ */
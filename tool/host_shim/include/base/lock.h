@@ -0,0 +1,39 @@
+/*
+ * \brief  Host shim: lock with scoped guard
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__LOCK_H_
+#define _HOST_SHIM__BASE__LOCK_H_
+
+#include <mutex>
+
+namespace Genode {
+
+	class Lock
+	{
+		private:
+
+			std::mutex _mutex;
+
+		public:
+
+			void lock()   { _mutex.lock(); }
+			void unlock() { _mutex.unlock(); }
+
+			class Guard
+			{
+				private:
+
+					Lock &_lock;
+
+				public:
+
+					explicit Guard(Lock &lock) : _lock(lock) { _lock.lock(); }
+					~Guard() { _lock.unlock(); }
+			};
+	};
+}
+
+#endif /* _HOST_SHIM__BASE__LOCK_H_ */
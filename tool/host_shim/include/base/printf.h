@@ -0,0 +1,44 @@
+/*
+ * \brief  Host shim: Genode log macros
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The messages are always formatted, as on the target,
+ * but only written to stderr if SHIM_LOG is set in the
+ * environment. This keeps the formatting cost in the
+ * benchmarks without flooding the terminal.
+ */
+
+#ifndef _HOST_SHIM__BASE__PRINTF_H_
+#define _HOST_SHIM__BASE__PRINTF_H_
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Genode {
+
+	using std::printf;
+
+	inline void shim_log(const char *prefix, const char *format, ...) __attribute__((format(printf, 2, 3)));
+	inline void shim_log(const char *prefix, const char *format, ...)
+	{
+		static bool enabled = std::getenv("SHIM_LOG") != nullptr;
+		static char buf[512];
+
+		va_list list;
+		va_start(list, format);
+		std::vsnprintf(buf, sizeof(buf), format, list);
+		va_end(list);
+
+		if (enabled)
+			std::fprintf(stderr, "%s%s\n", prefix, buf);
+	}
+}
+
+#define PDBG(fmt, ...) Genode::shim_log("", "%s: " fmt, __func__, ##__VA_ARGS__)
+#define PINF(fmt, ...) Genode::shim_log("", fmt, ##__VA_ARGS__)
+#define PWRN(fmt, ...) Genode::shim_log("Warning: ", fmt, ##__VA_ARGS__)
+#define PERR(fmt, ...) Genode::shim_log("Error: ", fmt, ##__VA_ARGS__)
+
+#endif /* _HOST_SHIM__BASE__PRINTF_H_ */
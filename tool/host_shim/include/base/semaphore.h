@@ -0,0 +1,43 @@
+/*
+ * \brief  Host shim: counting semaphore
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__SEMAPHORE_H_
+#define _HOST_SHIM__BASE__SEMAPHORE_H_
+
+#include <condition_variable>
+#include <mutex>
+
+namespace Genode {
+
+	class Semaphore
+	{
+		private:
+
+			std::mutex _mutex;
+			std::condition_variable _cond;
+			int _cnt;
+
+		public:
+
+			Semaphore(int n = 0) : _cnt(n) { }
+
+			void up()
+			{
+				std::lock_guard<std::mutex> guard(_mutex);
+				_cnt++;
+				_cond.notify_one();
+			}
+
+			void down()
+			{
+				std::unique_lock<std::mutex> guard(_mutex);
+				_cond.wait(guard, [this] { return _cnt > 0; });
+				_cnt--;
+			}
+	};
+}
+
+#endif /* _HOST_SHIM__BASE__SEMAPHORE_H_ */
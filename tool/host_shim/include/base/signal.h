@@ -0,0 +1,17 @@
+/*
+ * \brief  Host shim: signal types used as members only
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__SIGNAL_H_
+#define _HOST_SHIM__BASE__SIGNAL_H_
+
+namespace Genode {
+
+	struct Signal_context { };
+	struct Signal_receiver { };
+	struct Signal_context_capability { };
+}
+
+#endif /* _HOST_SHIM__BASE__SIGNAL_H_ */
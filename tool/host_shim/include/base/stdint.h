@@ -0,0 +1,25 @@
+/*
+ * \brief  Host shim: Genode integer types
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__STDINT_H_
+#define _HOST_SHIM__BASE__STDINT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Genode {
+
+	typedef std::size_t   size_t;
+	typedef std::uint64_t uint64_t;
+	typedef std::uint32_t uint32_t;
+	typedef std::uint16_t uint16_t;
+	typedef std::uint8_t  uint8_t;
+	typedef std::int64_t  int64_t;
+	typedef std::int32_t  int32_t;
+	typedef unsigned long addr_t;
+}
+
+#endif /* _HOST_SHIM__BASE__STDINT_H_ */
@@ -0,0 +1,90 @@
+/*
+ * \brief  Host shim: threads
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * A Genode thread runs as pthread. The affinity set via the
+ * CPU session is applied when the thread is started, cores
+ * beyond the host CPUs are wrapped around.
+ */
+
+#ifndef _HOST_SHIM__BASE__THREAD_H_
+#define _HOST_SHIM__BASE__THREAD_H_
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <base/affinity.h>
+#include <base/capability.h>
+
+namespace Genode {
+
+	class Thread_base
+	{
+		private:
+
+			pthread_t _thread;
+			bool _started = false;
+			bool _pinned = false;
+			Affinity::Location _location;
+
+			static void *_entry(void *arg)
+			{
+				static_cast<Thread_base *>(arg)->entry();
+				return nullptr;
+			}
+
+		public:
+
+			Thread_base(const char *) { }
+			virtual ~Thread_base() { }
+
+			virtual void entry() = 0;
+
+			Thread_capability cap()
+			{
+				Thread_capability cap;
+				cap.local = this;
+				return cap;
+			}
+
+			void affinity(Affinity::Location location)
+			{
+				_location = location;
+				_pinned = true;
+			}
+
+			void start()
+			{
+				pthread_attr_t attr;
+				pthread_attr_init(&attr);
+				if (_pinned) {
+					cpu_set_t set;
+					CPU_ZERO(&set);
+					CPU_SET(_location.xpos() % sysconf(_SC_NPROCESSORS_ONLN), &set);
+					pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+				}
+				pthread_create(&_thread, &attr, _entry, this);
+				pthread_attr_destroy(&attr);
+				_started = true;
+			}
+
+			void join()
+			{
+				if (_started)
+					pthread_join(_thread, nullptr);
+				_started = false;
+			}
+	};
+
+	template <unsigned STACK_SIZE>
+	class Thread : public Thread_base
+	{
+		public:
+
+			Thread(const char *name) : Thread_base(name) { }
+	};
+}
+
+#endif /* _HOST_SHIM__BASE__THREAD_H_ */
@@ -0,0 +1,18 @@
+/*
+ * \brief  Host shim: trace types
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__BASE__TRACE__TYPES_H_
+#define _HOST_SHIM__BASE__TRACE__TYPES_H_
+
+namespace Genode { namespace Trace {
+
+	struct Execution_time
+	{
+		unsigned long long value = 0;
+	};
+} }
+
+#endif /* _HOST_SHIM__BASE__TRACE__TYPES_H_ */
@@ -0,0 +1,24 @@
+/*
+ * \brief  Host shim: CPU session, only the thread affinity
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__CPU_SESSION__CPU_SESSION_H_
+#define _HOST_SHIM__CPU_SESSION__CPU_SESSION_H_
+
+#include <base/affinity.h>
+#include <base/thread.h>
+
+namespace Genode {
+
+	struct Cpu_session
+	{
+		void affinity(Thread_capability thread, Affinity::Location location)
+		{
+			static_cast<Thread_base *>(thread.local)->affinity(location);
+		}
+	};
+}
+
+#endif /* _HOST_SHIM__CPU_SESSION__CPU_SESSION_H_ */
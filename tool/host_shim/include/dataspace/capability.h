@@ -0,0 +1,12 @@
+/*
+ * \brief  Host shim: dataspace capability
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__DATASPACE__CAPABILITY_H_
+#define _HOST_SHIM__DATASPACE__CAPABILITY_H_
+
+#include <base/capability.h>
+
+#endif /* _HOST_SHIM__DATASPACE__CAPABILITY_H_ */
@@ -0,0 +1,104 @@
+/*
+ * \brief  Host shim: monitoring manager
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The monitoring data is not read from the kernel but
+ * from Mon_manager::Shim, which host drivers fill with
+ * the thread and RIP lists they want the controller to
+ * see. update_info() and update_dead() copy them into
+ * the given dataspaces, as the real service does. The
+ * optional hooks run before the copy, so a replay driver
+ * can fill in the next recorded snapshot.
+ */
+
+#ifndef _HOST_SHIM__MON_MANAGER__MON_MANAGER_H_
+#define _HOST_SHIM__MON_MANAGER__MON_MANAGER_H_
+
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <base/env.h>
+#include <base/trace/types.h>
+#include <util/string.h>
+
+namespace Mon_manager {
+
+	struct Affinity_location
+	{
+		int x = 0;
+
+		int xpos() const { return x; }
+	};
+
+	struct Monitoring_object
+	{
+		unsigned int foc_id;
+		int prio;
+		Genode::String<32> thread_name;
+		Genode::Trace::Execution_time execution_time;
+		unsigned long long arrival_time;
+		unsigned long long start_time;
+		unsigned long long exit_time;
+		Affinity_location affinity;
+	};
+
+	struct Shim
+	{
+		std::vector<Monitoring_object> threads;     /* terminated by foc_id 0 when copied */
+		std::vector<long long unsigned> rip;        /* (foc_id, time) tuples */
+		std::vector<int> rqs;                       /* (foc_id, prio) tuples of the kernel run queue */
+		int num_cores = 4;
+
+		std::function<void()> on_update_info;
+		std::function<void()> on_update_dead;
+
+		static Shim &inst()
+		{
+			static Shim shim;
+			return shim;
+		}
+	};
+
+	struct Connection
+	{
+		int get_num_cores() { return Shim::inst().num_cores; }
+
+		void update_rqs(Genode::Dataspace_capability ds)
+		{
+			int *rqs = (int *)ds.local;
+			std::vector<int> const &src = Shim::inst().rqs;
+			rqs[0] = src.size() / 2;
+			if (!src.empty())
+				std::memcpy(rqs + 1, src.data(), src.size() * sizeof(int));
+		}
+
+		void update_info(Genode::Dataspace_capability ds)
+		{
+			if (Shim::inst().on_update_info)
+				Shim::inst().on_update_info();
+			Monitoring_object *threads = (Monitoring_object *)ds.local;
+			size_t max = ds.size / sizeof(Monitoring_object);
+			std::vector<Monitoring_object> const &src = Shim::inst().threads;
+			size_t n = src.size() < max ? src.size() : max - 1;
+			for (size_t i = 0; i < max; i++)
+				threads[i] = (i < n) ? src[i] : Monitoring_object();
+		}
+
+		void update_dead(Genode::Dataspace_capability ds)
+		{
+			if (Shim::inst().on_update_dead)
+				Shim::inst().on_update_dead();
+			long long unsigned *rip = (long long unsigned *)ds.local;
+			std::vector<long long unsigned> const &src = Shim::inst().rip;
+			rip[0] = src.size() / 2;
+			if (!src.empty())
+				std::memcpy(rip + 1, src.data(), src.size() * sizeof(long long unsigned));
+		}
+
+		Genode::Trace::Execution_time get_idle_time(int) { return Genode::Trace::Execution_time(); }
+	};
+}
+
+#endif /* _HOST_SHIM__MON_MANAGER__MON_MANAGER_H_ */
@@ -0,0 +1,12 @@
+/*
+ * \brief  Host shim: connection to the monitoring manager
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__MON_MANAGER__MON_MANAGER_CONNECTION_H_
+#define _HOST_SHIM__MON_MANAGER__MON_MANAGER_CONNECTION_H_
+
+#include <mon_manager/mon_manager.h>
+
+#endif /* _HOST_SHIM__MON_MANAGER__MON_MANAGER_CONNECTION_H_ */
@@ -0,0 +1,12 @@
+/*
+ * \brief  Host shim: attached RAM dataspace
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__OS__ATTACHED_RAM_DATASPACE_H_
+#define _HOST_SHIM__OS__ATTACHED_RAM_DATASPACE_H_
+
+#include <base/env.h>
+
+#endif /* _HOST_SHIM__OS__ATTACHED_RAM_DATASPACE_H_ */
@@ -0,0 +1,35 @@
+/*
+ * \brief  Host shim: config ROM
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The config is taken from the GENODE_CONFIG environment
+ * variable, e.g. GENODE_CONFIG='<config admission="audsley"/>'.
+ */
+
+#ifndef _HOST_SHIM__OS__CONFIG_H_
+#define _HOST_SHIM__OS__CONFIG_H_
+
+#include <cstdlib>
+
+#include <util/xml_node.h>
+
+namespace Genode {
+
+	struct Config
+	{
+		Xml_node xml_node()
+		{
+			const char *config = std::getenv("GENODE_CONFIG");
+			return Xml_node(config ? config : "<config/>");
+		}
+	};
+
+	inline Config *config()
+	{
+		static Config inst;
+		return &inst;
+	}
+}
+
+#endif /* _HOST_SHIM__OS__CONFIG_H_ */
@@ -0,0 +1,12 @@
+/*
+ * \brief  Host shim: RAM session
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__RAM_SESSION__RAM_SESSION_H_
+#define _HOST_SHIM__RAM_SESSION__RAM_SESSION_H_
+
+#include <base/env.h>
+
+#endif /* _HOST_SHIM__RAM_SESSION__RAM_SESSION_H_ */
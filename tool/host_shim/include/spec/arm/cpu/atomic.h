@@ -0,0 +1,22 @@
+/*
+ * \brief  Host shim: atomic compare and exchange
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__SPEC__ARM__CPU__ATOMIC_H_
+#define _HOST_SHIM__SPEC__ARM__CPU__ATOMIC_H_
+
+namespace Genode {
+
+	/**
+	 * \return 1 if the value was exchanged, 0 otherwise
+	 */
+	inline int cmpxchg(volatile int *dest, int cmp_val, int new_val)
+	{
+		return __atomic_compare_exchange_n(dest, &cmp_val, new_val, false,
+		                                   __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	}
+}
+
+#endif /* _HOST_SHIM__SPEC__ARM__CPU__ATOMIC_H_ */
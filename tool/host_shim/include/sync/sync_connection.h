@@ -0,0 +1,20 @@
+/*
+ * \brief  Host shim: connection to the sync service
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__SYNC__SYNC_CONNECTION_H_
+#define _HOST_SHIM__SYNC__SYNC_CONNECTION_H_
+
+#include <base/env.h>
+
+namespace Sync {
+
+	struct Connection
+	{
+		void deploy(Genode::Dataspace_capability, int, int) { }
+	};
+}
+
+#endif /* _HOST_SHIM__SYNC__SYNC_CONNECTION_H_ */
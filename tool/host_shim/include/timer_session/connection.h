@@ -0,0 +1,46 @@
+/*
+ * \brief  Host shim: timer with a virtual clock
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * All timer connections share one virtual clock in ms.
+ * Sleeping advances the clock instead of blocking, so
+ * code that polls the timer runs at full speed on the
+ * host. Drivers set the clock with Timer::Clock::set().
+ * A replay driver can install a source instead, which
+ * then answers every elapsed_ms().
+ */
+
+#ifndef _HOST_SHIM__TIMER_SESSION__CONNECTION_H_
+#define _HOST_SHIM__TIMER_SESSION__CONNECTION_H_
+
+#include <functional>
+
+namespace Timer {
+
+	struct Clock
+	{
+		static std::function<unsigned long()> &source()
+		{
+			static std::function<unsigned long()> fn;
+			return fn;
+		}
+
+		static unsigned long &now_ms()
+		{
+			static unsigned long ms = 0;
+			return ms;
+		}
+
+		static void set(unsigned long ms) { now_ms() = ms; }
+	};
+
+	struct Connection
+	{
+		unsigned long elapsed_ms() const { return Clock::source() ? Clock::source()() : Clock::now_ms(); }
+		void msleep(unsigned ms) { Clock::now_ms() += ms; }
+		void usleep(unsigned us) { Clock::now_ms() += us / 1000; }
+	};
+}
+
+#endif /* _HOST_SHIM__TIMER_SESSION__CONNECTION_H_ */
@@ -0,0 +1,26 @@
+/*
+ * \brief  Host shim: cycle counter
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * The host has no portable cycle counter, the timestamp
+ * counts ns, i.e. it behaves like a 1000 MHz counter.
+ */
+
+#ifndef _HOST_SHIM__TRACE__TIMESTAMP_H_
+#define _HOST_SHIM__TRACE__TIMESTAMP_H_
+
+#include <chrono>
+
+namespace Genode { namespace Trace {
+
+	typedef unsigned long long Timestamp;
+
+	inline Timestamp timestamp()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+} }
+
+#endif /* _HOST_SHIM__TRACE__TIMESTAMP_H_ */
@@ -0,0 +1,65 @@
+/*
+ * \brief  Host shim: Genode string utilities
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__UTIL__STRING_H_
+#define _HOST_SHIM__UTIL__STRING_H_
+
+#include <cstring>
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	template <size_t CAPACITY>
+	class String
+	{
+		private:
+
+			char _buf[CAPACITY];
+
+		public:
+
+			String() { _buf[0] = 0; }
+
+			String(const char *str)
+			{
+				std::strncpy(_buf, str, CAPACITY - 1);
+				_buf[CAPACITY - 1] = 0;
+			}
+
+			const char *string() const { return _buf; }
+			size_t length() const { return std::strlen(_buf) + 1; }
+	};
+
+	/**
+	 * Size with an optional K, M or G suffix, as used in configs
+	 */
+	class Number_of_bytes
+	{
+		private:
+
+			size_t _n;
+
+		public:
+
+			Number_of_bytes(size_t n = 0) : _n(n) { }
+
+			operator size_t() const { return _n; }
+	};
+
+	inline size_t strlen(const char *s) { return std::strlen(s); }
+
+	inline int strcmp(const char *a, const char *b) { return std::strcmp(a, b); }
+
+	inline char *strncpy(char *dst, const char *src, size_t size)
+	{
+		std::strncpy(dst, src, size - 1);
+		dst[size - 1] = 0;
+		return dst;
+	}
+}
+
+#endif /* _HOST_SHIM__UTIL__STRING_H_ */
@@ -0,0 +1,10 @@
+/*
+ * \brief  Host shim: XML generator (unused on the host)
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#ifndef _HOST_SHIM__UTIL__XML_GENERATOR_H_
+#define _HOST_SHIM__UTIL__XML_GENERATOR_H_
+
+#endif /* _HOST_SHIM__UTIL__XML_GENERATOR_H_ */
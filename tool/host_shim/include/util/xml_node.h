@@ -0,0 +1,208 @@
+/*
+ * \brief  Host shim: minimal XML node parser
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Supports the subset of Genode::Xml_node that is used by
+ * the controller: sub nodes, content values and attributes.
+ * There is no validation, the input is expected to be
+ * well formed.
+ */
+
+#ifndef _HOST_SHIM__UTIL__XML_NODE_H_
+#define _HOST_SHIM__UTIL__XML_NODE_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <base/stdint.h>
+#include <util/string.h>
+
+namespace Genode {
+
+	class Xml_node
+	{
+		private:
+
+			const char *_begin; /* '<' of the start tag */
+			const char *_end;   /* first character behind the end tag */
+
+			static const char *_skip_ws(const char *p)
+			{
+				while (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r')
+					p++;
+				return p;
+			}
+
+			static const char *_find_end(const char *begin)
+			{
+				const char *tag_end = std::strchr(begin, '>');
+				if (tag_end[-1] == '/')
+					return tag_end + 1;
+
+				int depth = 1;
+				const char *p = tag_end + 1;
+				while (*p && depth) {
+					if (p[0] == '<' && p[1] == '/') {
+						depth--;
+						p = std::strchr(p, '>') + 1;
+						continue;
+					}
+					if (p[0] == '<' && p[1] != '!' && p[1] != '?') {
+						const char *t = std::strchr(p, '>');
+						if (t[-1] != '/')
+							depth++;
+						p = t + 1;
+						continue;
+					}
+					p++;
+				}
+				return p;
+			}
+
+			std::string _name() const
+			{
+				const char *p = _begin + 1;
+				const char *q = p;
+				while (*q && *q != ' ' && *q != '>' && *q != '/' && *q != '\n' && *q != '\t')
+					q++;
+				return std::string(p, q - p);
+			}
+
+			const char *_tag_end() const { return std::strchr(_begin, '>'); }
+
+			bool _empty_tag() const { return _tag_end()[-1] == '/'; }
+
+			const char *_content_begin() const { return _tag_end() + 1; }
+
+			const char *_content_end() const
+			{
+				if (_empty_tag())
+					return _content_begin();
+				const char *p = _end - 1;
+				while (*p != '<')
+					p--;
+				return p;
+			}
+
+			bool _attribute(const char *name, std::string &out) const
+			{
+				std::string tag(_begin, _tag_end() - _begin);
+				std::string key = std::string(" ") + name + "=\"";
+				size_t pos = tag.find(key);
+				if (pos == std::string::npos)
+					return false;
+				pos += key.size();
+				out = tag.substr(pos, tag.find('"', pos) - pos);
+				return true;
+			}
+
+			template <size_t N>
+			static String<N> _convert(std::string const &s, String<N>) { return String<N>(s.c_str()); }
+			static unsigned long long _convert(std::string const &s, unsigned long long) { return std::strtoull(s.c_str(), nullptr, 0); }
+			static unsigned long _convert(std::string const &s, unsigned long) { return std::strtoul(s.c_str(), nullptr, 0); }
+			static unsigned _convert(std::string const &s, unsigned) { return std::strtoul(s.c_str(), nullptr, 0); }
+			static long _convert(std::string const &s, long) { return std::strtol(s.c_str(), nullptr, 0); }
+			static int _convert(std::string const &s, int) { return std::strtol(s.c_str(), nullptr, 0); }
+			static double _convert(std::string const &s, double) { return std::strtod(s.c_str(), nullptr); }
+			static Number_of_bytes _convert(std::string const &s, Number_of_bytes)
+			{
+				char *end = nullptr;
+				size_t n = std::strtoull(s.c_str(), &end, 0);
+				switch (*end) {
+				case 'G': n <<= 10; /* fall through */
+				case 'M': n <<= 10; /* fall through */
+				case 'K': n <<= 10; break;
+				default: break;
+				}
+				return Number_of_bytes(n);
+			}
+			static bool _convert(std::string const &s, bool) { return s == "yes" || s == "true" || s == "1"; }
+
+		public:
+
+			struct Nonexistent_sub_node { };
+
+			Xml_node(const char *xml) : _begin(_skip_ws(xml))
+			{
+				/* skip processing instructions and comments */
+				while (_begin[0] == '<' && (_begin[1] == '?' || _begin[1] == '!'))
+					_begin = _skip_ws(std::strchr(_begin, '>') + 1);
+				_end = _find_end(_begin);
+			}
+
+			template <typename FN>
+			void for_each_sub_node(const char *type, FN const &fn) const
+			{
+				if (_empty_tag())
+					return;
+
+				const char *p = _content_begin();
+				const char *end = _content_end();
+				while (p < end) {
+					p = std::strchr(p, '<');
+					if (!p || p >= end)
+						return;
+					if (p[1] == '!' || p[1] == '?') {
+						p = std::strchr(p, '>') + 1;
+						continue;
+					}
+					Xml_node node(p);
+					if (!type || node._name() == type)
+						fn(node);
+					p = node._end;
+				}
+			}
+
+			template <typename FN>
+			void for_each_sub_node(FN const &fn) const { for_each_sub_node(nullptr, fn); }
+
+			bool has_type(const char *type) const { return _name() == type; }
+
+			bool has_sub_node(const char *type) const
+			{
+				bool found = false;
+				for_each_sub_node(type, [&] (Xml_node const &) { found = true; });
+				return found;
+			}
+
+			Xml_node sub_node(const char *type) const
+			{
+				const char *found = nullptr;
+				for_each_sub_node(type, [&] (Xml_node const &node) {
+					if (!found)
+						found = node._begin;
+				});
+				if (!found)
+					throw Nonexistent_sub_node();
+				return Xml_node(found);
+			}
+
+			void value(char *dst, size_t max_len) const
+			{
+				size_t len = _content_end() - _content_begin();
+				if (len >= max_len)
+					len = max_len - 1;
+				std::memcpy(dst, _content_begin(), len);
+				dst[len] = 0;
+			}
+
+			bool has_attribute(const char *name) const
+			{
+				std::string s;
+				return _attribute(name, s);
+			}
+
+			template <typename T>
+			T attribute_value(const char *name, T default_value) const
+			{
+				std::string s;
+				if (!_attribute(name, s))
+					return default_value;
+				return _convert(s, default_value);
+			}
+	};
+}
+
+#endif /* _HOST_SHIM__UTIL__XML_NODE_H_ */
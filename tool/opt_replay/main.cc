@@ -0,0 +1,413 @@
+/*
+ * \brief  Replay of recorded optimizer inputs
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Feeds a recording of the Opt_recorder through Sched_opt at
+ * full speed. Timer reads, monitoring and RIP snapshots are
+ * answered from the recording via the hooks of the host shim.
+ * After every optimization the state digest is compared with
+ * the recorded one, as is every scheduling_allowed() result,
+ * so any change of the optimizer decisions is reported.
+ *
+ * Usage: opt_replay [-x] [-l loops] [-v] file
+ *        opt_replay -w file [-n tasks] [-r rounds]
+ *   -x  file is a LOG capture with the "opt_trace:" lines of
+ *       the dump_opt_trace() RPC instead of a binary recording
+ *   -l  replay the recording several times, e.g. for profiling
+ *   -v  print every mismatch
+ *   -w  write a synthetic recording of n tasks over r rounds
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <base/env.h>
+#include <timer_session/connection.h>
+#include <mon_manager/mon_manager.h>
+
+#include "sched_controller/opt_recorder.h"
+#include "sched_controller/sched_opt.h"
+
+namespace Opt_replay {
+
+	using namespace Sched_controller;
+
+	typedef std::chrono::steady_clock Clock;
+
+	enum { MAX_THREADS = 100 };
+
+	struct Desync
+	{
+		unsigned expected;
+		unsigned found;
+	};
+
+	/**
+	 * Optimizer with the dataspaces of a controller
+	 */
+	struct Optimizer
+	{
+		Mon_manager::Connection mon;
+		Genode::Dataspace_capability mon_ds = Genode::env()->ram_session()->alloc(MAX_THREADS * sizeof(Mon_manager::Monitoring_object));
+		Genode::Dataspace_capability dead_ds = Genode::env()->ram_session()->alloc(Opt_trace::RIP_SIZE * sizeof(long long unsigned));
+		Sched_opt opt;
+
+		Optimizer(int num_cores)
+		: opt(num_cores, &mon, Genode::env()->rm_session()->attach(mon_ds), mon_ds, dead_ds) { }
+
+		void set_goal(const char *xml)
+		{
+			Genode::Ram_dataspace_capability ds = Genode::env()->ram_session()->alloc(std::strlen(xml) + 1);
+			std::strcpy((char *)ds.local, xml);
+			opt.set_goal(ds);
+			Genode::env()->ram_session()->free(ds);
+		}
+	};
+
+	struct Stats
+	{
+		unsigned long long records = 0;
+		unsigned long long decisions = 0;
+		unsigned long long digests = 0;
+		unsigned long long mismatches = 0;
+		std::vector<double> ns;
+	};
+
+	class Replay
+	{
+		private:
+
+			Opt_trace::Reader _reader;
+			bool _verbose;
+			Stats &_stats;
+
+			Opt_trace::Record _record;
+			const char *_payload = nullptr;
+
+			bool _next()
+			{
+				if (!_reader.next(&_record, &_payload))
+					return false;
+				_stats.records++;
+				return true;
+			}
+
+			const char *_expect(Opt_trace::Type type)
+			{
+				if (!_next())
+					throw Desync { (unsigned)type, 0 };
+				if (_record.type != (unsigned)type)
+					throw Desync { (unsigned)type, _record.type };
+				return _payload;
+			}
+
+			void _mismatch(const char *what, const char *task)
+			{
+				_stats.mismatches++;
+				if (_verbose)
+					std::printf("mismatch: %s of %s (record %llu)\n", what, task, _stats.records);
+			}
+
+		public:
+
+			Replay(const void *recording, bool verbose, Stats &stats)
+			: _reader(recording), _verbose(verbose), _stats(stats) { }
+
+			void run(Optimizer &o)
+			{
+				Mon_manager::Shim &shim = Mon_manager::Shim::inst();
+
+				Timer::Clock::source() = [&] () -> unsigned long {
+					Genode::uint64_t ms;
+					std::memcpy(&ms, _expect(Opt_trace::TIME), sizeof(ms));
+					return ms;
+				};
+
+				shim.on_update_info = [&] () {
+					const char *p = _expect(Opt_trace::MONITOR);
+					unsigned n = _record.len / sizeof(Opt_trace::Thread);
+					shim.threads.clear();
+					for (unsigned i = 0; i < n; i++) {
+						Opt_trace::Thread t;
+						std::memcpy(&t, p + i * sizeof(t), sizeof(t));
+						Mon_manager::Monitoring_object m = Mon_manager::Monitoring_object();
+						m.foc_id = t.foc_id;
+						m.prio = t.prio;
+						m.thread_name = Genode::String<32>(t.name);
+						m.execution_time.value = t.execution_time;
+						m.arrival_time = t.arrival_time;
+						m.start_time = t.start_time;
+						m.exit_time = t.exit_time;
+						m.affinity.x = t.core;
+						shim.threads.push_back(m);
+					}
+				};
+
+				shim.on_update_dead = [&] () {
+					const char *p = _expect(Opt_trace::RIP);
+					std::vector<Genode::uint64_t> rip(_record.len / sizeof(Genode::uint64_t));
+					std::memcpy(rip.data(), p, rip.size() * sizeof(Genode::uint64_t));
+					shim.rip.assign(rip.begin() + 1, rip.end());
+				};
+
+				while (_next()) {
+					switch (_record.type) {
+					case Opt_trace::GOAL:
+						o.set_goal(_payload);
+						break;
+
+					case Opt_trace::ADD_TASK:
+					{
+						Opt_trace::Task t;
+						std::memcpy(&t, _payload, sizeof(t));
+						Rq_task::Rq_task task = Rq_task::Rq_task();
+						task.task_id = t.task_id;
+						task.task_class = (Rq_task::Task_class)t.task_class;
+						task.task_strategy = (Rq_task::Task_strategy)t.task_strategy;
+						task.prio = t.prio;
+						task.deadline = t.deadline;
+						task.wcet = t.wcet;
+						task.wcet_hi = t.wcet_hi;
+						task.inter_arrival = t.inter_arrival;
+						task.jitter = t.jitter;
+						task.blocking = t.blocking;
+						task.valid = true;
+						std::memcpy(task.name, t.name, sizeof(task.name));
+						o.opt.add_task(t.core, task);
+						break;
+					}
+
+					case Opt_trace::START_OPTIMIZING:
+					case Opt_trace::CHECK_DUE:
+					{
+						std::string name(_payload);
+						Clock::time_point start = Clock::now();
+						if (_record.type == Opt_trace::CHECK_DUE)
+							o.opt.check_due();
+						else
+							o.opt.start_optimizing(name);
+						_stats.ns.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+						_stats.decisions++;
+
+						Genode::uint64_t digest;
+						std::memcpy(&digest, _expect(Opt_trace::DIGEST), sizeof(digest));
+						_stats.digests++;
+						if (digest != o.opt.state_digest())
+							_mismatch("state digest", name.c_str());
+						break;
+					}
+
+					case Opt_trace::SCHEDULING_ALLOWED:
+					{
+						Genode::int32_t expected;
+						std::memcpy(&expected, _payload, sizeof(expected));
+						std::string name(_payload + sizeof(expected));
+						if (o.opt.scheduling_allowed(name) != expected)
+							_mismatch("scheduling_allowed", name.c_str());
+						break;
+					}
+
+					case Opt_trace::LAST_JOB_STARTED:
+						o.opt.last_job_started(_payload);
+						break;
+
+					case Opt_trace::REMOVE_TASK:
+						o.opt.remove_task(_payload);
+						break;
+
+					default:
+						throw Desync { 0, _record.type };
+					}
+				}
+
+				Timer::Clock::source() = nullptr;
+				shim.on_update_info = nullptr;
+				shim.on_update_dead = nullptr;
+			}
+	};
+
+	bool load(const char *path, bool hex, std::vector<char> *data)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		if (!hex) {
+			data->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			return true;
+		}
+
+		auto nibble = [] (char c) -> int {
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			return -1;
+		};
+
+		std::string line;
+		while (std::getline(file, line)) {
+			size_t pos = line.find("opt_trace: ");
+			if (pos == std::string::npos)
+				continue;
+			for (pos += 11; pos + 1 < line.size(); pos += 2) {
+				int hi = nibble(line[pos]), lo = nibble(line[pos + 1]);
+				if (hi < 0 || lo < 0)
+					break;
+				data->push_back((char)(hi << 4 | lo));
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Record the optimizer while n tasks release one job per round,
+	 * every third job misses its deadline
+	 */
+	int write_synthetic(const char *path, int n, int rounds)
+	{
+		enum { NUM_CORES = 4, PERIOD = 100 };
+		n = std::min(n, MAX_THREADS - 1);
+
+		Optimizer o(NUM_CORES);
+		Opt_recorder recorder(64 * 1024 * 1024, NUM_CORES);
+		o.opt.record(&recorder);
+
+		o.set_goal("<config><goal><fairness><apply>1</apply></fairness>"
+		           "<utilization><apply>0</apply></utilization></goal>"
+		           "<query_interval>10</query_interval></config>");
+
+		for (int i = 0; i < n; i++) {
+			Rq_task::Rq_task t = Rq_task::Rq_task();
+			t.task_class = Rq_task::Task_class::lo;
+			t.inter_arrival = PERIOD;
+			t.deadline = PERIOD;
+			std::snprintf(t.name, sizeof(t.name), "task%d", i);
+			o.opt.add_task(i % NUM_CORES, t);
+		}
+
+		Mon_manager::Shim &shim = Mon_manager::Shim::inst();
+		std::mt19937 gen(n);
+		unsigned foc_id = 1;
+		for (int r = 1; r <= rounds; r++) {
+			unsigned long long release = r * PERIOD;
+			shim.threads.clear();
+			for (int i = 0; i < n; i++) {
+				Mon_manager::Monitoring_object m = Mon_manager::Monitoring_object();
+				m.foc_id = foc_id++;
+				m.thread_name = Genode::String<32>((std::string("task") + std::to_string(i)).c_str());
+				m.arrival_time = release;
+				m.start_time = release + gen() % 10;
+				m.exit_time = (gen() % 3 == 0) ? release + PERIOD + 5 : release + 50;
+				m.execution_time.value = 40;
+				m.affinity.x = i % NUM_CORES;
+				shim.threads.push_back(m);
+			}
+
+			Timer::Clock::set(release + PERIOD);
+			for (int i = 0; i < n; i++) {
+				std::string name = std::string("task") + std::to_string(i);
+				o.opt.start_optimizing(name);
+				o.opt.scheduling_allowed(name);
+			}
+		}
+
+		Opt_trace::Header *header = Genode::env()->rm_session()->attach(recorder.dataspace());
+		std::ofstream file(path, std::ios::binary);
+		file.write((const char *)header, sizeof(*header) + header->used);
+		std::printf("wrote %u bytes, %u records dropped\n", (unsigned)(sizeof(*header) + header->used), header->dropped);
+		return file ? 0 : 1;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	using namespace Opt_replay;
+
+	const char *path = nullptr;
+	const char *out = nullptr;
+	bool hex = false, verbose = false;
+	int loops = 1, tasks = 16, rounds = 100;
+
+	for (int i = 1; i < argc; i++) {
+		bool has_arg = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-x")) {
+			hex = true;
+		} else if (!std::strcmp(argv[i], "-v")) {
+			verbose = true;
+		} else if (!std::strcmp(argv[i], "-l") && has_arg) {
+			loops = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-w") && has_arg) {
+			out = argv[++i];
+		} else if (!std::strcmp(argv[i], "-n") && has_arg) {
+			tasks = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-r") && has_arg) {
+			rounds = std::atoi(argv[++i]);
+		} else if (argv[i][0] != '-' && !path) {
+			path = argv[i];
+		} else {
+			path = out = nullptr;
+			break;
+		}
+	}
+
+	if (out)
+		return write_synthetic(out, tasks, rounds);
+
+	if (!path) {
+		std::fprintf(stderr, "usage: %s [-x] [-l loops] [-v] file\n"
+		                     "       %s -w file [-n tasks] [-r rounds]\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	std::vector<char> data;
+	if (!load(path, hex, &data)) {
+		std::fprintf(stderr, "cannot read %s\n", path);
+		return 1;
+	}
+
+	Opt_trace::Header header;
+	if (data.size() < sizeof(header)) {
+		std::fprintf(stderr, "%s: recording too short\n", path);
+		return 1;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != Opt_trace::MAGIC || header.version != Opt_trace::VERSION
+	    || sizeof(header) + header.used > data.size()) {
+		std::fprintf(stderr, "%s: not a recording of version %d\n", path, Opt_trace::VERSION);
+		return 1;
+	}
+	if (header.dropped)
+		std::printf("warning: %u records were dropped, the replay stops at the first gap\n", header.dropped);
+
+	Stats stats;
+	Clock::time_point start = Clock::now();
+	for (int l = 0; l < loops; l++) {
+		Optimizer o(header.num_cores);
+		try {
+			Replay(data.data(), verbose, stats).run(o);
+		} catch (Desync d) {
+			std::printf("desync at record %llu: expected type %u, found %u\n", stats.records, d.expected, d.found);
+			stats.mismatches++;
+			break;
+		}
+	}
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::sort(stats.ns.begin(), stats.ns.end());
+	auto pct = [&] (double p) {
+		return stats.ns.empty() ? 0.0 : stats.ns[std::min(stats.ns.size() - 1, (size_t)(p * stats.ns.size()))];
+	};
+	std::printf("records %llu, decisions %llu, digests %llu, mismatches %llu\n",
+	            stats.records, stats.decisions, stats.digests, stats.mismatches);
+	std::printf("%.0f decisions/s, p50 %.0f ns, p99 %.0f ns, max %.0f ns\n",
+	            seconds > 0 ? stats.decisions / seconds : 0.0, pct(0.5), pct(0.99), pct(1.0));
+
+	return stats.mismatches ? 2 : 0;
+}
@@ -0,0 +1,481 @@
+/*
+ * \brief  Host-side micro benchmarks of the scheduling controller
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Measures the admission path (Rq_buffer, sufficient tests, RTA),
+ * the interference kernel of the RTA (scalar and vectorized), the
+ * evaluation of the candidate cores of an allocation (sequential and
+ * on the admission pool) and the optimizer decisions over
+ * parameterised task set sizes.
+ * Every operation is timed individually, the report shows the
+ * mean and the percentiles in ns per operation.
+ *
+ * With -s, the admission ratio sweep of src/taskset_gen is run
+ * instead: for every utilization step up to -u, -r task sets of
+ * the first size of -n are generated and admitted by each test.
+ *
+ * Usage: sched_bench [-n 4,16,64] [-r repetitions] [-u utilization] [-c] [-s]
+ *   -n  comma separated task set sizes
+ *   -r  repetitions per size
+ *   -u  total utilization of the generated task sets
+ *   -c  print CSV instead of a table
+ *   -s  run the admission ratio sweep
+ *
+ * The vectorized interference kernel is the one the CPU supports,
+ * see sched_controller/interference.h, e.g.
+ *   sched_bench -n 16,32,64,128,256,512 -r 10000
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <base/env.h>
+#include <timer_session/connection.h>
+#include <mon_manager/mon_manager.h>
+
+#include "rq_task/rq_task.h"
+#include "sched_controller/admission_pool.h"
+#include "sched_controller/interference.h"
+#include "sched_controller/rq_buffer.h"
+#include "sched_controller/sched_alg.h"
+#include "sched_controller/sched_opt.h"
+#include "sched_controller/sensitivity.h"
+#include "taskset_gen/admission_ratio.h"
+#include "taskset_gen/taskset_gen.h"
+
+namespace Sched_bench {
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Samples
+	{
+		std::vector<double> ns;
+
+		void add(Clock::time_point start, Clock::time_point end, int ops = 1)
+		{
+			ns.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+		}
+
+		double percentile(double p)
+		{
+			if (ns.empty())
+				return 0;
+			std::sort(ns.begin(), ns.end());
+			size_t i = (size_t)std::ceil(p * ns.size()) - 1;
+			return ns[std::min(i, ns.size() - 1)];
+		}
+
+		double mean()
+		{
+			double sum = 0;
+			for (double v : ns)
+				sum += v;
+			return ns.empty() ? 0 : sum / ns.size();
+		}
+	};
+
+	static bool csv = false;
+
+	void report(const char *name, int tasks, Samples &s)
+	{
+		if (csv) {
+			std::printf("%s,%d,%.1f,%.1f,%.1f,%.1f,%.1f\n", name, tasks, s.mean(),
+			            s.percentile(0.5), s.percentile(0.9), s.percentile(0.99), s.percentile(1.0));
+			return;
+		}
+		std::printf("%-22s %6d %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, tasks, s.mean(),
+		            s.percentile(0.5), s.percentile(0.9), s.percentile(0.99), s.percentile(1.0));
+	}
+
+	/**
+	 * Generate n implicit-deadline tasks with total utilization u
+	 * (UUniFast), log-uniform periods and rate monotonic priorities,
+	 * sorted from the highest to the lowest priority. The priorities
+	 * are even, so a task can be inserted between any two of them.
+	 */
+	std::vector<Rq_task::Rq_task> task_set(int n, double u, unsigned seed)
+	{
+		Taskset_gen::Params params;
+		params.num_tasks = n;
+		params.utilization = u;
+
+		std::vector<Rq_task::Rq_task> tasks;
+		Taskset_gen::Generator(seed).task_set(params, &tasks);
+		for (auto &t : tasks)
+			t.prio *= 2;
+		return tasks;
+	}
+
+	Sched_controller::Rq_buffer<Rq_task::Rq_entry> *new_rq_buffer()
+	{
+		auto *buf = new Sched_controller::Rq_buffer<Rq_task::Rq_entry>();
+		buf->init_w_shared_ds(Genode::env()->ram_session()->alloc(4 * sizeof(int) + 10000 * sizeof(Rq_task::Rq_entry)));
+		return buf;
+	}
+
+	void bench_rq_buffer(int n, int reps)
+	{
+		auto *buf = new_rq_buffer();
+		std::vector<Rq_task::Rq_task> tasks = task_set(n, 0.5, n);
+		Samples enq, deq;
+
+		for (int r = 0; r < reps; r++) {
+			for (auto &t : tasks) {
+				Clock::time_point start = Clock::now();
+				buf->enq(t);
+				enq.add(start, Clock::now());
+			}
+			Rq_task::Rq_entry *t;
+			for (int i = 0; i < n; i++) {
+				Clock::time_point start = Clock::now();
+				buf->deq(&t);
+				deq.add(start, Clock::now());
+			}
+		}
+		report("rq_buffer.enq", n, enq);
+		report("rq_buffer.deq", n, deq);
+	}
+
+	/**
+	 * The WCET slack of the sensitivity analysis has to agree with
+	 * the RTA for two tasks of equal priority, which interfere with
+	 * each other: a grows by the slack of b and still fits, b with
+	 * one unit more does not
+	 */
+	void check_equal_priority()
+	{
+		Rq_task::Rq_task a { }, b { };
+		std::strcpy(a.name, "a");
+		a.task_id = 1; a.prio = 5; a.wcet = 3; a.deadline = 5; a.inter_arrival = 10;
+		std::strcpy(b.name, "b");
+		b.task_id = 2; b.prio = 5; b.wcet = 1; b.deadline = 10; b.inter_arrival = 10;
+
+		Sched_controller::Rq_view view, without_b;
+		view.insert(a);
+		view.insert(b);
+		without_b.insert(a);
+
+		Sched_controller::Sched_sensitivity sensitivity(1);
+		long long slack = sensitivity.wcet_slack(0, &view, "b");
+
+		Sched_controller::Sched_alg alg;
+		Rq_task::Rq_task fits = b, misses = b;
+		fits.wcet += slack;
+		misses.wcet += slack + 1;
+		if (slack != 1 || !alg.RTA(&fits, &without_b) || alg.RTA(&misses, &without_b)) {
+			std::fprintf(stderr, "sensitivity: slack %lld of a task of equal priority differs from the RTA\n", slack);
+			std::exit(1);
+		}
+	}
+
+	void bench_sched_alg(int n, double u, int reps)
+	{
+		/* the middle task of n + 1 tasks is the one that gets admitted */
+		std::vector<Rq_task::Rq_task> tasks = task_set(n + 1, u, n);
+		Rq_task::Rq_task new_task = tasks[n / 2];
+		new_task.prio -= 1;
+		tasks.erase(tasks.begin() + n / 2);
+
+		Sched_controller::Rq_view view;
+		Sched_controller::Sched_alg alg;
+		Sched_controller::Rq_util util;
+		Sched_controller::Sched_alg::reset_util(&util);
+		for (auto &t : tasks) {
+			bool rm = util.rate_monotonic && alg.rate_monotonic(&t, &view);
+			view.insert(t);
+			alg.add_util(&util, &t, rm);
+		}
+		bool rm = util.rate_monotonic && alg.rate_monotonic(&new_task, &view);
+
+		/* at most 16 fixed-point iterations, see Sched_alg::budget() */
+		enum { BUDGET = 16 };
+
+		Samples sufficient, cascade, rta, budgeted;
+		for (int r = 0; r < reps; r++) {
+			Clock::time_point start = Clock::now();
+			alg.fp_sufficient_test(&new_task, &view);
+			sufficient.add(start, Clock::now());
+
+			start = Clock::now();
+			alg.fp_admission_test(&new_task, &view, &util, rm);
+			cascade.add(start, Clock::now());
+
+			start = Clock::now();
+			alg.RTA(&new_task, &view);
+			rta.add(start, Clock::now());
+
+			start = Clock::now();
+			alg.budget(BUDGET, 0);
+			alg.RTA(&new_task, &view);
+			budgeted.add(start, Clock::now());
+			alg.budget(0, 0);
+		}
+		report("sched_alg.sufficient", n, sufficient);
+		report("sched_alg.cascade", n, cascade);
+		report("sched_alg.rta", n, rta);
+		report("sched_alg.rta_budget", n, budgeted);
+	}
+
+	/**
+	 * One fixed-point step of the RTA over n interfering tasks, with
+	 * the scalar loop and with the vectorized kernel of the target
+	 */
+	void bench_interference(int n, int reps)
+	{
+		enum { BATCH = 16 }; /* a single call is too short for the clock */
+
+		std::vector<Rq_task::Rq_task> tasks = task_set(n, 0.9, n);
+		Sched_controller::Rq_view view;
+		for (auto &t : tasks)
+			view.push_back(t);
+		unsigned long long w = tasks.back().deadline;
+
+		using namespace Sched_controller::Interference;
+		if (scalar(view.wcet.data(), view.period.data(), view.jitter.data(), n, w)
+		    != simd(view.wcet.data(), view.period.data(), view.jitter.data(), n, w)) {
+			std::fprintf(stderr, "interference: %s differs from the scalar kernel\n", simd_name());
+			std::exit(1);
+		}
+
+		Samples sc, vec;
+		volatile unsigned long long sink = 0;
+		for (int r = 0; r < reps; r++) {
+			Clock::time_point start = Clock::now();
+			for (int b = 0; b < BATCH; b++)
+				sink = sink + scalar(view.wcet.data(), view.period.data(), view.jitter.data(), n, w + b);
+			sc.add(start, Clock::now(), BATCH);
+
+			start = Clock::now();
+			for (int b = 0; b < BATCH; b++)
+				sink = sink + simd(view.wcet.data(), view.period.data(), view.jitter.data(), n, w + b);
+			vec.add(start, Clock::now(), BATCH);
+		}
+		report("interference.scalar", n, sc);
+		std::string name = std::string("interference.") + simd_name();
+		report(name.c_str(), n, vec);
+	}
+
+	/**
+	 * Admission test of a new task on every core, each core holding
+	 * n tasks, in the calling thread and on a pool with one worker
+	 * per core
+	 */
+	void bench_allocation(int n, double u, int reps)
+	{
+		enum { CORES = 8 };
+
+		using Sched_controller::Admission_pool;
+		Admission_pool sequential(CORES, 0), pool(CORES, CORES);
+
+		Sched_controller::Sched_alg alg;
+		for (int c = 0; c < CORES; c++) {
+			Sched_controller::Rq_view view;
+			Sched_controller::Rq_util util;
+			Sched_controller::Sched_alg::reset_util(&util);
+			for (auto &t : task_set(n, u, n * CORES + c)) {
+				bool rm = util.rate_monotonic && alg.rate_monotonic(&t, &view);
+				view.insert(t);
+				alg.add_util(&util, &t, rm);
+			}
+			sequential.snapshot(c, &view, &util);
+			pool.snapshot(c, &view, &util);
+		}
+
+		/* the longest period at the lowest priority keeps the run queues rate monotonic */
+		Rq_task::Rq_task new_task = task_set(1, 0.05, n).front();
+		new_task.task_class = Rq_task::Task_class::hi;
+		new_task.inter_arrival = new_task.deadline = Taskset_gen::Params().period_max;
+		new_task.wcet = new_task.inter_arrival / 20;
+		new_task.prio = -1;
+
+		std::vector<Admission_pool::Verdict> a, b;
+		for (int c = 0; c < CORES; c++)
+			a.push_back({ c, false, 0 });
+		b = a;
+
+		sequential.evaluate(new_task, Admission_pool::Test::fp, &a);
+		pool.evaluate(new_task, Admission_pool::Test::fp, &b);
+		for (int c = 0; c < CORES; c++) {
+			if (a[c].admissible != b[c].admissible || a[c].headroom != b[c].headroom) {
+				std::fprintf(stderr, "allocation: the pool differs from the sequential evaluation on core %d\n", c);
+				std::exit(1);
+			}
+		}
+
+		Samples seq, par;
+		for (int r = 0; r < reps; r++) {
+			Clock::time_point start = Clock::now();
+			sequential.evaluate(new_task, Admission_pool::Test::fp, &a);
+			seq.add(start, Clock::now());
+
+			start = Clock::now();
+			pool.evaluate(new_task, Admission_pool::Test::fp, &b);
+			par.add(start, Clock::now());
+		}
+		report("allocation.sequential", n, seq);
+		report("allocation.pool", n, par);
+	}
+
+	void bench_sched_opt(int n, int reps)
+	{
+		enum { MAX_THREADS = 100, NUM_CORES = 4, PERIOD = 100 };
+
+		/* the monitoring dataspace holds 100 objects, one thread per task and round */
+		n = std::min(n, MAX_THREADS - 1);
+
+		Mon_manager::Connection mon;
+		Genode::Dataspace_capability mon_ds = Genode::env()->ram_session()->alloc(MAX_THREADS * sizeof(Mon_manager::Monitoring_object));
+		Genode::Dataspace_capability dead_ds = Genode::env()->ram_session()->alloc(256 * sizeof(long long unsigned));
+		Mon_manager::Monitoring_object *threads = Genode::env()->rm_session()->attach(mon_ds);
+
+		Sched_controller::Sched_opt opt(NUM_CORES, &mon, threads, mon_ds, dead_ds);
+
+		const char *goal = "<config><goal><fairness><apply>1</apply></fairness>"
+		                   "<utilization><apply>0</apply></utilization></goal>"
+		                   "<query_interval>10</query_interval></config>";
+		Genode::Ram_dataspace_capability goal_ds = Genode::env()->ram_session()->alloc(std::strlen(goal) + 1);
+		std::strcpy((char *)goal_ds.local, goal);
+		opt.set_goal(goal_ds);
+
+		for (int i = 0; i < n; i++) {
+			Rq_task::Rq_task t { };
+			t.task_class = Rq_task::Task_class::lo;
+			t.inter_arrival = PERIOD;
+			t.deadline = PERIOD;
+			std::snprintf(t.name, sizeof(t.name), "task%d", i);
+			opt.add_task(i % NUM_CORES, t);
+		}
+
+		/*
+		 * In every round each task releases one job, every third
+		 * job misses its deadline, so the optimizer has to find
+		 * competitors and update the scheduling permissions.
+		 */
+		Mon_manager::Shim &shim = Mon_manager::Shim::inst();
+		std::mt19937 gen(n);
+		Samples decide, allowed;
+		unsigned foc_id = 1;
+		for (int r = 1; r <= reps; r++) {
+			unsigned long long release = r * PERIOD;
+
+			shim.threads.clear();
+			for (int i = 0; i < n; i++) {
+				Mon_manager::Monitoring_object o = Mon_manager::Monitoring_object();
+				o.foc_id = foc_id++;
+				o.thread_name = Genode::String<32>((std::string("task") + std::to_string(i)).c_str());
+				o.arrival_time = release;
+				o.start_time = release + gen() % 10;
+				o.exit_time = (gen() % 3 == 0) ? release + PERIOD + 5 : release + 50;
+				o.execution_time.value = 40;
+				o.affinity.x = i % NUM_CORES;
+				shim.threads.push_back(o);
+			}
+
+			Timer::Clock::set(release + PERIOD);
+			for (int i = 0; i < n; i++) {
+				std::string name = std::string("task") + std::to_string(i);
+
+				Clock::time_point start = Clock::now();
+				opt.start_optimizing(name);
+				decide.add(start, Clock::now());
+
+				start = Clock::now();
+				opt.scheduling_allowed(name);
+				allowed.add(start, Clock::now());
+			}
+		}
+		report("sched_opt.optimize", n, decide);
+		report("sched_opt.allowed", n, allowed);
+	}
+
+	unsigned long long now_ns()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	void report_ratio(Taskset_gen::Sweep_result const &r)
+	{
+		double ratio = r.sets ? (double)r.accepted / r.sets : 0.0;
+		if (csv) {
+			std::printf("%s,%.2f,%u,%u,%.3f,%llu,%llu,%llu\n", Taskset_gen::test_name(r.test), r.utilization,
+			            r.sets, r.accepted, ratio, r.mean_ns, r.p99_ns, r.max_ns);
+			return;
+		}
+		std::printf("%-14s %6.2f %6u %8u %8.3f %10llu %10llu %10llu\n", Taskset_gen::test_name(r.test), r.utilization,
+		            r.sets, r.accepted, ratio, r.mean_ns, r.p99_ns, r.max_ns);
+	}
+
+	void sweep(int n, double u, int sets)
+	{
+		Taskset_gen::Sweep_config config;
+		config.params.num_tasks = n;
+		config.util_max = u;
+		config.sets_per_step = sets;
+
+		if (csv)
+			std::printf("test,utilization,sets,accepted,ratio,mean_ns,p99_ns,max_ns\n");
+		else
+			std::printf("%-14s %6s %6s %8s %8s %10s %10s %10s\n", "test", "util", "sets", "accepted", "ratio", "ns/op", "p99", "max");
+
+		Taskset_gen::Admission_ratio bench(config, now_ns);
+		bench.run(report_ratio);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	using namespace Sched_bench;
+
+	std::vector<int> sizes = { 4, 8, 16, 32, 64, 128 };
+	int reps = 1000;
+	double u = 0.7;
+	bool ratio = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!std::strcmp(argv[i], "-n") && i + 1 < argc) {
+			sizes.clear();
+			for (char *tok = std::strtok(argv[++i], ","); tok; tok = std::strtok(nullptr, ","))
+				sizes.push_back(std::atoi(tok));
+		} else if (!std::strcmp(argv[i], "-r") && i + 1 < argc) {
+			reps = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-u") && i + 1 < argc) {
+			u = std::atof(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-c")) {
+			csv = true;
+		} else if (!std::strcmp(argv[i], "-s")) {
+			ratio = true;
+		} else {
+			std::fprintf(stderr, "usage: %s [-n 4,16,64] [-r repetitions] [-u utilization] [-c] [-s]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	check_equal_priority();
+
+	if (ratio) {
+		sweep(sizes.empty() ? 8 : sizes.front(), u, reps);
+		return 0;
+	}
+
+	if (csv)
+		std::printf("benchmark,tasks,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n");
+	else
+		std::printf("%-22s %6s %10s %10s %10s %10s %10s\n", "benchmark", "tasks", "ns/op", "p50", "p90", "p99", "max");
+
+	for (int n : sizes) {
+		bench_rq_buffer(n, reps);
+		bench_sched_alg(n, u, reps);
+		bench_interference(n, reps);
+		bench_allocation(n, u, reps);
+		bench_sched_opt(n, reps);
+	}
+	return 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * \brief  Offline validation of the admission decisions
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * With -f, the run queues of a file are simulated and the observed
+ * response times are compared with the RTA bounds. The file mirrors
+ * the fields of Rq_task:
+ *
+ * <runqueues>
+ *   <rq core="0" policy="fp">
+ *     <task name="a" wcet="10" period="100" deadline="100" prio="2" jitter="0"/>
+ *   </rq>
+ * </runqueues>
+ *
+ * With -g, random task sets are generated for every utilization,
+ * admitted by the exact test of the policy (RTA for fp, QPA for edf)
+ * and simulated in parallel. Admitted sets with a deadline miss are
+ * wrong verdicts, rejected sets without a miss and the ratio of the
+ * observed to the analysed response time show the pessimism.
+ *
+ * Usage: sched_sim -f file [-r pattern] [-H horizon] [-e exec_min]
+ *        sched_sim -g [-n tasks] [-u 0.5,0.9] [-s sets] [-j threads] [-p fp|edf]
+ *                     [-d deadline_ratio_min] [-r pattern] [-H horizon] [-e exec_min] [-c]
+ *   -r  periodic, critical, jitter or sporadic release pattern
+ *   -H  simulated time, 0 for one hyperperiod
+ *   -e  minimal execution time as fraction of the wcet
+ *   -c  print CSV instead of a table
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <util/xml_node.h>
+
+#include "sched_controller/sched_alg.h"
+#include "taskset_gen/taskset_gen.h"
+#include "simulator.h"
+
+namespace Sched_sim {
+
+	static bool csv = false;
+
+	/**
+	 * Sort tasks from the highest to the lowest priority and compute
+	 * their RTA bounds, 0 for tasks that are not schedulable
+	 */
+	std::vector<unsigned long long> rta_bounds(std::vector<Rq_task::Rq_task> &tasks)
+	{
+		std::stable_sort(tasks.begin(), tasks.end(), [] (Rq_task::Rq_task const &a, Rq_task::Rq_task const &b) {
+			return a.prio > b.prio;
+		});
+		Sched_controller::Rq_view view;
+		for (auto &t : tasks)
+			view.push_back(t);
+
+		Sched_controller::Sched_alg alg;
+		std::vector<unsigned long long> bounds;
+		for (unsigned i = 0; i < tasks.size(); i++)
+			bounds.push_back(alg.response_time(&view, i));
+		return bounds;
+	}
+
+	bool admitted(Policy policy, std::vector<Rq_task::Rq_task> &tasks, std::vector<unsigned long long> *bounds)
+	{
+		if (policy == Policy::fp) {
+			*bounds = rta_bounds(tasks);
+			return std::find(bounds->begin(), bounds->end(), 0ULL) == bounds->end();
+		}
+		Sched_controller::Rq_view view;
+		for (auto &t : tasks)
+			view.push_back(t);
+		return Sched_controller::Sched_alg().edf_schedulable(&view);
+	}
+
+	int simulate_file(const char *path, Config config)
+	{
+		std::ifstream file(path);
+		if (!file) {
+			std::fprintf(stderr, "cannot open %s\n", path);
+			return 1;
+		}
+		std::stringstream ss;
+		ss << file.rdbuf();
+		std::string xml = ss.str();
+
+		int misses = 0;
+		std::printf("%-4s %-4s %-16s %8s %8s %10s %10s %10s %8s\n", "core", "pol", "task", "jobs", "misses",
+		            "max_resp", "rta_bound", "deadline", "preempt");
+
+		Genode::Xml_node(xml.c_str()).for_each_sub_node("rq", [&] (Genode::Xml_node const &rq) {
+			int core = rq.attribute_value("core", 0);
+			bool edf = !Genode::strcmp(rq.attribute_value("policy", Genode::String<8>("fp")).string(), "edf");
+
+			std::vector<Rq_task::Rq_task> tasks;
+			rq.for_each_sub_node("task", [&] (Genode::Xml_node const &node) {
+				Rq_task::Rq_task t = Rq_task::Rq_task();
+				std::snprintf(t.name, sizeof(t.name), "%s", node.attribute_value("name", Genode::String<24>("")).string());
+				t.wcet          = node.attribute_value("wcet", 0ULL);
+				t.inter_arrival = node.attribute_value("period", 0ULL);
+				t.deadline      = node.attribute_value("deadline", t.inter_arrival);
+				t.jitter        = node.attribute_value("jitter", 0ULL);
+				t.prio          = node.attribute_value("prio", 0);
+				t.task_strategy = edf ? Rq_task::Task_strategy::deadline : Rq_task::Task_strategy::priority;
+				t.valid = true;
+				tasks.push_back(t);
+			});
+
+			config.policy = edf ? Policy::edf : Policy::fp;
+			std::vector<unsigned long long> bounds;
+			if (!edf)
+				bounds = rta_bounds(tasks);
+
+			Result result = simulate(tasks, config);
+			for (unsigned i = 0; i < tasks.size(); i++) {
+				Task_result &r = result.tasks[i];
+				std::printf("%-4d %-4s %-16s %8llu %8llu %10llu %10llu %10llu %8llu\n", core, edf ? "edf" : "fp",
+				            tasks[i].name, r.jobs, r.misses, r.max_response, edf ? 0 : bounds[i],
+				            tasks[i].deadline, r.preemptions);
+			}
+			if (result.truncated)
+				std::printf("core %d: hyperperiod truncated to %llu\n", core, result.horizon);
+			misses += result.misses;
+		});
+		return misses ? 2 : 0;
+	}
+
+	struct Set_result
+	{
+		bool generated = false;
+		bool admitted = false;
+		bool missed = false;
+		bool truncated = false;
+		double pessimism = 0; /* min of observed / bound over the tasks of the set */
+		unsigned long long preemptions = 0;
+		unsigned long long jobs = 0;
+	};
+
+	void sweep(Taskset_gen::Params params, std::vector<double> const &utils, unsigned sets,
+	           unsigned threads, Config config)
+	{
+		if (csv)
+			std::printf("policy,utilization,sets,admitted,admitted_missed,rejected_no_miss,min_ratio,mean_ratio,preemptions_per_job,truncated\n");
+		else
+			std::printf("%-4s %6s %6s %8s %8s %8s %9s %9s %9s %6s\n", "pol", "util", "sets", "admitted", "adm_miss",
+			            "rej_ok", "min_ratio", "avg_ratio", "pre/job", "trunc");
+
+		for (double u : utils) {
+			std::vector<Set_result> results(sets);
+			std::atomic<unsigned> next { 0 };
+
+			auto worker = [&] () {
+				std::vector<Rq_task::Rq_task> tasks;
+				std::vector<unsigned long long> bounds;
+				for (unsigned s = next++; s < sets; s = next++) {
+					Taskset_gen::Params p = params;
+					p.utilization = u;
+					Taskset_gen::Generator gen(config.seed + s);
+					if (!gen.task_set(p, &tasks))
+						continue;
+
+					Set_result &r = results[s];
+					r.generated = true;
+					r.admitted = admitted(config.policy, tasks, &bounds);
+
+					Config c = config;
+					c.seed = config.seed + s;
+					Result sim = simulate(tasks, c);
+					r.missed = sim.misses > 0;
+					r.truncated = sim.truncated;
+					r.preemptions = sim.preemptions;
+					r.jobs = sim.jobs;
+
+					r.pessimism = 1.0;
+					if (config.policy == Policy::fp && r.admitted) {
+						for (unsigned i = 0; i < tasks.size(); i++)
+							r.pessimism = std::min(r.pessimism, (double)sim.tasks[i].max_response / bounds[i]);
+					}
+				}
+			};
+
+			std::vector<std::thread> pool;
+			for (unsigned i = 0; i < std::max(threads, 1U); i++)
+				pool.emplace_back(worker);
+			for (auto &t : pool)
+				t.join();
+
+			unsigned generated = 0, num_admitted = 0, admitted_missed = 0, rejected_ok = 0, truncated = 0;
+			double min_ratio = 1.0, sum_ratio = 0.0;
+			unsigned long long preemptions = 0, jobs = 0;
+			for (auto &r : results) {
+				if (!r.generated)
+					continue;
+				generated++;
+				truncated += r.truncated;
+				preemptions += r.preemptions;
+				jobs += r.jobs;
+				if (r.admitted) {
+					num_admitted++;
+					admitted_missed += r.missed;
+					min_ratio = std::min(min_ratio, r.pessimism);
+					sum_ratio += r.pessimism;
+				} else if (!r.missed) {
+					rejected_ok++;
+				}
+			}
+			double mean_ratio = num_admitted ? sum_ratio / num_admitted : 0.0;
+			double per_job = jobs ? (double)preemptions / jobs : 0.0;
+			const char *pol = config.policy == Policy::edf ? "edf" : "fp";
+
+			if (csv)
+				std::printf("%s,%.2f,%u,%u,%u,%u,%.3f,%.3f,%.3f,%u\n", pol, u, generated, num_admitted,
+				            admitted_missed, rejected_ok, min_ratio, mean_ratio, per_job, truncated);
+			else
+				std::printf("%-4s %6.2f %6u %8u %8u %8u %9.3f %9.3f %9.3f %6u\n", pol, u, generated, num_admitted,
+				            admitted_missed, rejected_ok, min_ratio, mean_ratio, per_job, truncated);
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	using namespace Sched_sim;
+
+	Config config;
+	Taskset_gen::Params params;
+	params.period_min = 1000;
+	params.period_max = 100000;
+	params.period_granularity = 1000;
+
+	const char *file = nullptr;
+	bool generate = false;
+	std::vector<double> utils = { 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+	unsigned sets = 1000;
+	unsigned threads = std::thread::hardware_concurrency();
+
+	for (int i = 1; i < argc; i++) {
+		bool has_arg = i + 1 < argc;
+		if (!std::strcmp(argv[i], "-f") && has_arg) {
+			file = argv[++i];
+		} else if (!std::strcmp(argv[i], "-g")) {
+			generate = true;
+		} else if (!std::strcmp(argv[i], "-n") && has_arg) {
+			params.num_tasks = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-u") && has_arg) {
+			utils.clear();
+			for (char *tok = std::strtok(argv[++i], ","); tok; tok = std::strtok(nullptr, ","))
+				utils.push_back(std::atof(tok));
+		} else if (!std::strcmp(argv[i], "-s") && has_arg) {
+			sets = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-j") && has_arg) {
+			threads = std::atoi(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-p") && has_arg) {
+			config.policy = !std::strcmp(argv[++i], "edf") ? Policy::edf : Policy::fp;
+		} else if (!std::strcmp(argv[i], "-d") && has_arg) {
+			params.deadline_ratio_min = std::atof(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-r") && has_arg) {
+			const char *p = argv[++i];
+			config.pattern = !std::strcmp(p, "periodic") ? Pattern::periodic
+			               : !std::strcmp(p, "jitter")   ? Pattern::jitter
+			               : !std::strcmp(p, "sporadic") ? Pattern::sporadic
+			                                             : Pattern::critical;
+		} else if (!std::strcmp(argv[i], "-H") && has_arg) {
+			config.horizon = std::strtoull(argv[++i], nullptr, 0);
+		} else if (!std::strcmp(argv[i], "-e") && has_arg) {
+			config.exec_min = std::atof(argv[++i]);
+		} else if (!std::strcmp(argv[i], "-c")) {
+			csv = true;
+		} else {
+			file = nullptr;
+			generate = false;
+			break;
+		}
+	}
+
+	if (file)
+		return simulate_file(file, config);
+	if (generate) {
+		params.strategy = config.policy == Policy::edf ? Rq_task::Task_strategy::deadline
+		                                               : Rq_task::Task_strategy::priority;
+		sweep(params, utils, sets, threads, config);
+		return 0;
+	}
+
+	std::fprintf(stderr, "usage: %s -f file [-r pattern] [-H horizon] [-e exec_min]\n"
+	                     "       %s -g [-n tasks] [-u 0.5,0.9] [-s sets] [-j threads] [-p fp|edf]\n"
+	                     "             [-d deadline_ratio_min] [-r pattern] [-H horizon] [-e exec_min] [-c]\n",
+	             argv[0], argv[0]);
+	return 1;
+}
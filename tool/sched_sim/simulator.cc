@@ -0,0 +1,175 @@
+/*
+ * \brief  Discrete-event simulation of one core
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ */
+
+#include <algorithm>
+#include <random>
+
+#include "simulator.h"
+
+namespace Sched_sim
+{
+
+	struct Job
+	{
+		unsigned task;
+		unsigned long long id;
+		unsigned long long arrival;
+		unsigned long long abs_deadline;
+		unsigned long long remaining;
+	};
+
+	struct Source
+	{
+		unsigned long long arrival; /* of the next job */
+		unsigned long long release;
+		unsigned long long count;
+	};
+
+	unsigned long long hyperperiod(std::vector<Rq_task::Rq_task> const &tasks, unsigned long long limit)
+	{
+		unsigned long long h = 1;
+		for (auto &t : tasks) {
+			if (t.inter_arrival == 0)
+				continue;
+			unsigned long long a = h, b = t.inter_arrival;
+			while (b) {
+				unsigned long long r = a % b;
+				a = b;
+				b = r;
+			}
+			if (h / a > limit / t.inter_arrival)
+				return limit;
+			h = h / a * t.inter_arrival;
+		}
+		return std::min(h, limit);
+	}
+
+	Result simulate(std::vector<Rq_task::Rq_task> const &tasks, Config const &config)
+	{
+		const unsigned long long NONE = ~0ULL;
+		unsigned n = tasks.size();
+
+		Result result;
+		result.tasks.resize(n);
+		if (config.horizon) {
+			result.horizon = config.horizon;
+		} else {
+			result.horizon = hyperperiod(tasks, config.max_horizon);
+			result.truncated = result.horizon == config.max_horizon;
+		}
+
+		std::mt19937 gen(config.seed);
+		std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+		auto delay = [&] (unsigned i, unsigned long long count) -> unsigned long long {
+			switch (config.pattern) {
+			case Pattern::critical: return count == 0 ? tasks[i].jitter : 0;
+			case Pattern::jitter:   return (unsigned long long)(uniform(gen) * tasks[i].jitter);
+			default:                return 0;
+			}
+		};
+
+		std::vector<Source> sources(n);
+		for (unsigned i = 0; i < n; i++) {
+			sources[i].arrival = 0;
+			sources[i].release = delay(i, 0);
+			sources[i].count = 0;
+			if (tasks[i].inter_arrival == 0)
+				sources[i].arrival = sources[i].release = NONE;
+		}
+
+		auto next_release = [&] () {
+			unsigned long long next = NONE;
+			for (auto &s : sources)
+				if (s.arrival < result.horizon)
+					next = std::min(next, s.release);
+			return next;
+		};
+
+		/* order of the jobs, true if a runs before b */
+		auto before = [&] (Job const &a, Job const &b) {
+			if (config.policy == Policy::edf) {
+				if (a.abs_deadline != b.abs_deadline)
+					return a.abs_deadline < b.abs_deadline;
+			} else if (tasks[a.task].prio != tasks[b.task].prio) {
+				return tasks[a.task].prio > tasks[b.task].prio;
+			}
+			if (a.arrival != b.arrival)
+				return a.arrival < b.arrival;
+			return a.task < b.task;
+		};
+
+		std::vector<Job> ready;
+		unsigned long long next_id = 0;
+		unsigned long long running = NONE;
+		unsigned long long t = 0;
+
+		while (true) {
+			/* release all jobs that are due */
+			for (unsigned i = 0; i < n; i++) {
+				Source &s = sources[i];
+				while (s.arrival < result.horizon && s.release <= t) {
+					unsigned long long exec = tasks[i].wcet;
+					if (config.exec_min < 1.0)
+						exec = std::max(1ULL, (unsigned long long)(exec * (config.exec_min + uniform(gen) * (1.0 - config.exec_min))));
+					ready.push_back(Job { i, next_id++, s.arrival, s.arrival + tasks[i].deadline, exec });
+
+					unsigned long long gap = tasks[i].inter_arrival;
+					if (config.pattern == Pattern::sporadic)
+						gap += (unsigned long long)(uniform(gen) * config.sporadic_gap * tasks[i].inter_arrival);
+					s.count++;
+					s.arrival += gap;
+					s.release = s.arrival + delay(i, s.count);
+				}
+			}
+
+			unsigned long long next = next_release();
+			if (ready.empty()) {
+				if (next == NONE)
+					break;
+				t = next;
+				continue;
+			}
+
+			auto job = std::min_element(ready.begin(), ready.end(), before);
+			if (running != NONE && running != job->id) {
+				/* the previous job is still ready, so it got preempted */
+				for (auto &j : ready) {
+					if (j.id == running) {
+						result.tasks[j.task].preemptions++;
+						break;
+					}
+				}
+			}
+
+			unsigned long long run = job->remaining;
+			if (next != NONE && next > t)
+				run = std::min(run, next - t);
+			t += run;
+			job->remaining -= run;
+
+			if (job->remaining > 0) {
+				running = job->id;
+				continue;
+			}
+
+			Task_result &r = result.tasks[job->task];
+			r.jobs++;
+			r.max_response = std::max(r.max_response, t - job->arrival);
+			if (t > job->abs_deadline)
+				r.misses++;
+			ready.erase(job);
+			running = NONE;
+		}
+
+		for (auto &r : result.tasks) {
+			result.jobs += r.jobs;
+			result.misses += r.misses;
+			result.preemptions += r.preemptions;
+		}
+		return result;
+	}
+}
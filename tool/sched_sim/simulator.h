@@ -0,0 +1,76 @@
+/*
+ * \brief  Discrete-event simulation of one core
+ * \author Barbara Niedermeier
+ * \date   2026/10/19
+ *
+ * Simulates the jobs of a run queue under preemptive fixed
+ * priority or EDF scheduling. Time advances from event to
+ * event, i.e. from a release or completion to the next one,
+ * so the cost depends on the number of jobs, not on the
+ * length of the horizon. Blocking is not simulated, there
+ * are no shared resources on the host.
+ */
+
+#ifndef _TOOL__SCHED_SIM__SIMULATOR_H_
+#define _TOOL__SCHED_SIM__SIMULATOR_H_
+
+#include <vector>
+
+#include "rq_task/rq_task.h"
+
+namespace Sched_sim
+{
+
+	enum class Policy { fp, edf };
+
+	/*
+	 * periodic: every job is released at its arrival k * T
+	 * critical: the first job of every task is delayed by its
+	 *           full jitter, the following ones are not, which
+	 *           is the worst case assumed by the RTA
+	 * jitter:   every release is delayed by a random jitter
+	 * sporadic: random gaps between the arrivals, no jitter
+	 */
+	enum class Pattern { periodic, critical, jitter, sporadic };
+
+	struct Config
+	{
+		Policy policy = Policy::fp;
+		Pattern pattern = Pattern::critical;
+		unsigned long long horizon = 0;            /* 0: one hyperperiod */
+		unsigned long long max_horizon = 100000000; /* cap of the hyperperiod */
+		double sporadic_gap = 0.5;                  /* max extra gap, fraction of T */
+		double exec_min = 1.0;                      /* min execution time, fraction of wcet */
+		unsigned seed = 1;
+	};
+
+	struct Task_result
+	{
+		unsigned long long jobs = 0;
+		unsigned long long misses = 0;
+		unsigned long long max_response = 0;        /* from arrival to completion */
+		unsigned long long preemptions = 0;
+	};
+
+	struct Result
+	{
+		std::vector<Task_result> tasks;             /* in the order of the input */
+		unsigned long long horizon = 0;
+		unsigned long long jobs = 0;
+		unsigned long long misses = 0;
+		unsigned long long preemptions = 0;
+		bool truncated = false;                     /* hyperperiod exceeded max_horizon */
+	};
+
+	/*
+	 * Least common multiple of the periods, limit if it is larger
+	 */
+	unsigned long long hyperperiod(std::vector<Rq_task::Rq_task> const &tasks, unsigned long long limit);
+
+	/*
+	 * Simulate all jobs that arrive before the horizon until they complete
+	 */
+	Result simulate(std::vector<Rq_task::Rq_task> const &tasks, Config const &config);
+}
+
+#endif /* _TOOL__SCHED_SIM__SIMULATOR_H_ */